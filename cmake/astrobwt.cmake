@@ -3,10 +3,12 @@ if (WITH_ASTROBWT)
 
     list(APPEND HEADERS_CRYPTO
         src/crypto/astrobwt/AstroBWT.h
+        src/crypto/astrobwt/sais.h
     )
 
     list(APPEND SOURCES_CRYPTO
         src/crypto/astrobwt/AstroBWT.cpp
+        src/crypto/astrobwt/sais.cpp
     )
 
     if (XMRIG_ARM)
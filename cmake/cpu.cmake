@@ -13,19 +13,26 @@ include(CheckCXXCompilerFlag)
 
 if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
     set(VAES_SUPPORTED ON)
+    set(VAES512_SUPPORTED ON)
 else()
     CHECK_CXX_COMPILER_FLAG("-mavx2 -mvaes" VAES_SUPPORTED)
+    CHECK_CXX_COMPILER_FLAG("-mavx512f -mvaes" VAES512_SUPPORTED)
 endif()
 
 if (NOT VAES_SUPPORTED)
     set(WITH_VAES OFF)
 endif()
 
+if (NOT VAES512_SUPPORTED)
+    set(WITH_VAES512 OFF)
+endif()
+
 if (XMRIG_64_BIT AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
     add_definitions(-DRAPIDJSON_SSE2)
 else()
     set(WITH_SSE4_1 OFF)
     set(WITH_VAES OFF)
+    set(WITH_VAES512 OFF)
 endif()
 
 if (NOT ARM_TARGET)
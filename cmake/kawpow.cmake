@@ -4,6 +4,7 @@ if (WITH_KAWPOW)
     list(APPEND HEADERS_CRYPTO
         src/crypto/kawpow/KPCache.h
         src/crypto/kawpow/KPHash.h
+        src/crypto/kawpow/KPHash_test.h
     )
 
     list(APPEND SOURCES_CRYPTO
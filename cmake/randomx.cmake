@@ -114,12 +114,14 @@ if (WITH_RANDOMX)
         list(APPEND HEADERS_CRYPTO
             src/crypto/rx/RxFix.h
             src/crypto/rx/RxMsr.h
+            src/crypto/rx/RxMsrExplorer.h
             src/hw/msr/Msr.h
             src/hw/msr/MsrItem.h
             )
 
         list(APPEND SOURCES_CRYPTO
             src/crypto/rx/RxMsr.cpp
+            src/crypto/rx/RxMsrExplorer.cpp
             src/hw/msr/Msr.cpp
             src/hw/msr/MsrItem.cpp
             )
@@ -129,6 +131,15 @@ if (WITH_RANDOMX)
         message("-- WITH_MSR=OFF")
     endif()
 
+    if (XMRIG_OS_LINUX)
+        add_definitions(/DXMRIG_FEATURE_RESCTRL)
+
+        list(APPEND HEADERS_CRYPTO src/crypto/rx/RxResctrl.h)
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxResctrl.cpp)
+    else()
+        remove_definitions(/DXMRIG_FEATURE_RESCTRL)
+    endif()
+
     if (WITH_PROFILING)
         add_definitions(/DXMRIG_FEATURE_PROFILING)
 
@@ -137,4 +148,5 @@ if (WITH_RANDOMX)
     endif()
 else()
     remove_definitions(/DXMRIG_ALGO_RANDOMX)
+    remove_definitions(/DXMRIG_FEATURE_RESCTRL)
 endif()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Decoder for the binary HTTP API snapshot (GET /2/snapshot), see doc/API.md.
+#
+# As a tool:    snapshot_decode.py http://127.0.0.1:8080/2/snapshot [access-token]
+#               snapshot_decode.py snapshot.bin
+# As a library: from snapshot_decode import decode; decode(data) -> dict
+
+import json
+import struct
+import sys
+import urllib.request
+
+MAGIC   = 0x53524d58
+VERSION = 1
+
+SECTION_HASHRATE = 1
+SECTION_RESULTS  = 2
+SECTION_BACKEND  = 3
+
+
+def _hashrate(values):
+    return [None if v != v else v for v in values]
+
+
+def decode(data):
+    magic, version, sections, timestamp, uptime = struct.unpack_from('<IHHQQ', data, 0)
+    if magic != MAGIC:
+        raise ValueError('not an xmrig snapshot')
+
+    if version > VERSION:
+        raise ValueError('unsupported snapshot version %d' % version)
+
+    out    = {'version': version, 'timestamp': timestamp, 'uptime': uptime, 'backends': []}
+    offset = 24
+
+    for _ in range(sections):
+        kind, _, size = struct.unpack_from('<HHI', data, offset)
+        offset += 8
+        payload = data[offset:offset + size]
+        offset += size
+
+        if kind == SECTION_HASHRATE:
+            values = _hashrate(struct.unpack_from('<4f', payload))
+            out['hashrate'] = {'total': values[:3], 'highest': values[3]}
+        elif kind == SECTION_RESULTS:
+            diff, good, bad, hashes, avg_time_ms, best, ping, failures = struct.unpack_from('<6Q2I', payload)
+            out['results'] = {
+                'diff_current': diff,
+                'shares_good': good,
+                'shares_total': good + bad,
+                'hashes_total': hashes,
+                'avg_time_ms': avg_time_ms,
+                'best': best,
+                'ping': ping,
+                'failures': failures
+            }
+        elif kind == SECTION_BACKEND:
+            name, enabled, threads = struct.unpack_from('<8sII', payload)
+            values = _hashrate(struct.unpack_from('<%df' % (3 + threads * 3), payload, 16))
+            out['backends'].append({
+                'type': name.rstrip(b'\0').decode(),
+                'enabled': bool(enabled),
+                'hashrate': values[:3],
+                'threads': [values[3 + i * 3:6 + i * 3] for i in range(threads)]
+            })
+
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: %s <url|file> [access-token]' % sys.argv[0], file=sys.stderr)
+        return 1
+
+    source = sys.argv[1]
+    if source.startswith('http://') or source.startswith('https://'):
+        request = urllib.request.Request(source)
+        if len(sys.argv) > 2:
+            request.add_header('Authorization', 'Bearer ' + sys.argv[2])
+
+        data = urllib.request.urlopen(request).read()
+    else:
+        with open(source, 'rb') as f:
+            data = f.read()
+
+    print(json.dumps(decode(data), indent=4))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
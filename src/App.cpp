@@ -49,6 +49,7 @@ xmrig::App::App(Process *process)
 
 xmrig::App::~App()
 {
+    Log::destroy();
     Cpu::release();
 }
 
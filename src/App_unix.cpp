@@ -40,7 +40,12 @@ bool xmrig::App::background(int &rc)
         return false;
     }
 
+    // The log writer thread would not survive fork(), the queue is drained and the thread is restarted in both processes.
+    Log::suspend();
+
     int i = fork();
+    Log::resume();
+
     if (i < 0) {
         rc = 1;
 
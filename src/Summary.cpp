@@ -121,7 +121,7 @@ static void print_cpu(const Config *)
 }
 
 
-static void print_memory(const Config *config)
+static void print_memory(Controller *controller)
 {
     constexpr size_t oneGiB = 1024U * 1024U * 1024U;
     const auto freeMem      = static_cast<double>(uv_get_free_memory());
@@ -137,14 +137,12 @@ static void print_memory(const Config *config)
                );
 
 #   ifdef XMRIG_FEATURE_DMI
-    if (!config->isDMI()) {
+    const DmiReader *dmi = controller->dmi();
+    if (!dmi) {
         return;
     }
 
-    DmiReader reader;
-    if (!reader.read()) {
-        return;
-    }
+    const DmiReader &reader = *dmi;
 
     const bool printEmpty = reader.memory().size() <= 8;
 
@@ -218,7 +216,7 @@ void xmrig::Summary::print(Controller *controller)
     config->printVersions();
     print_pages(config);
     print_cpu(config);
-    print_memory(config);
+    print_memory(controller);
     print_threads(config);
     config->pools().print();
 
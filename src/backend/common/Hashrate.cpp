@@ -80,6 +80,49 @@ double xmrig::Hashrate::average() const
 }
 
 
+// New set of threads, sources[i] is the previous index of thread i or -1, kept threads and the total keep their history
+void xmrig::Hashrate::remap(const std::vector<int64_t> &sources)
+{
+    const size_t threads = sources.size() + 1;
+    auto counts          = new uint64_t*[threads];
+    auto timestamps      = new uint64_t*[threads];
+    auto top             = new uint32_t[threads];
+    std::vector<bool> used(m_threads, false);
+
+    for (size_t i = 0; i < threads; i++) {
+        const size_t source = i == 0 ? 0 : static_cast<size_t>(sources[i - 1] + 1);
+
+        if ((i == 0 || sources[i - 1] >= 0) && source < m_threads && !used[source]) {
+            counts[i]       = m_counts[source];
+            timestamps[i]   = m_timestamps[source];
+            top[i]          = m_top[source];
+            used[source]    = true;
+        }
+        else {
+            counts[i]       = new uint64_t[kBucketSize]();
+            timestamps[i]   = new uint64_t[kBucketSize]();
+            top[i]          = 0;
+        }
+    }
+
+    for (size_t i = 0; i < m_threads; i++) {
+        if (!used[i]) {
+            delete [] m_counts[i];
+            delete [] m_timestamps[i];
+        }
+    }
+
+    delete [] m_counts;
+    delete [] m_timestamps;
+    delete [] m_top;
+
+    m_threads    = threads;
+    m_counts     = counts;
+    m_timestamps = timestamps;
+    m_top        = top;
+}
+
+
 const char *xmrig::Hashrate::format(double h, char *buf, size_t size)
 {
     return ::format(h, buf, size);
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 
 #include "3rdparty/rapidjson/fwd.h"
@@ -54,6 +55,7 @@ public:
     inline void add(uint64_t count, uint64_t timestamp)                     { addData(0U, count, timestamp); }
 
     double average() const;
+    void remap(const std::vector<int64_t> &sources);
 
     static const char *format(double h, char *buf, size_t size);
     static rapidjson::Value normalize(double d);
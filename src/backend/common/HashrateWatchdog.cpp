@@ -0,0 +1,215 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/common/HashrateWatchdog.h"
+#include "backend/common/Hashrate.h"
+#include "base/io/log/Log.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/document.h"
+#endif
+
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace xmrig {
+
+
+constexpr static uint64_t kInterval         = 10000;        // ms between checks, the short hashrate window
+constexpr static uint64_t kRestartCooldown  = 900000;       // ms before the same thread can be recreated again
+constexpr static uint32_t kConfirm          = 3;            // low checks in a row before a thread is reported
+constexpr static uint32_t kGrace            = 6;            // checks skipped after a restart, until the 60s window is clean again
+constexpr static uint32_t kMaxRestarts      = 3;
+constexpr static uint32_t kRestartAfter     = 6;            // low checks in a row before a thread is recreated
+constexpr static uint32_t kWarmup           = 6;            // baseline samples before a thread is judged
+
+
+} // namespace xmrig
+
+
+xmrig::HashrateWatchdog::HashrateWatchdog(const char *tag, size_t threads, uint32_t threshold, bool restart) :
+    m_restart(restart),
+    m_tag(tag),
+    m_threshold(threshold),
+    m_threads(threads)
+{
+}
+
+
+size_t xmrig::HashrateWatchdog::degraded() const
+{
+    return static_cast<size_t>(std::count_if(m_threads.begin(), m_threads.end(), [](const State &state) { return state.degraded; }));
+}
+
+
+std::vector<size_t> xmrig::HashrateWatchdog::check(const Hashrate &hashrate, uint64_t now)
+{
+    std::vector<size_t> restart;
+
+    if (!isEnabled() || now - m_lastCheck < kInterval) {
+        return restart;
+    }
+
+    m_lastCheck = now;
+
+    const size_t count = std::min(m_threads.size(), hashrate.threads());
+    std::vector<double> current;
+    current.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const double h = hashrate.calc(i, Hashrate::ShortInterval);
+        m_threads[i].last = std::isnormal(h) ? h : 0.0;
+
+        if (m_threads[i].last > 0.0) {
+            current.push_back(m_threads[i].last);
+        }
+    }
+
+    // Mining is paused or just started
+    if (current.size() < std::max<size_t>(count / 2, 1)) {
+        return restart;
+    }
+
+    std::nth_element(current.begin(), current.begin() + current.size() / 2, current.end());
+
+    const double median = current[current.size() / 2];
+    const double limit  = m_threshold / 100.0;
+
+    for (size_t i = 0; i < count; ++i) {
+        State &state = m_threads[i];
+
+        if (state.grace > 0) {
+            --state.grace;
+            continue;
+        }
+
+        const double h = state.last;
+        const bool low = state.samples >= kWarmup && h < state.baseline * limit && h < median * limit;
+
+        if (!low) {
+            if (state.degraded) {
+                LOG_INFO("%s " GREEN("thread ") GREEN_BOLD("#%zu") GREEN(" recovered, %.0f%% of its baseline"), m_tag, i, h * 100.0 / state.baseline);
+            }
+
+            state.degraded = false;
+            state.low      = 0;
+
+            const double h60 = hashrate.calc(i, Hashrate::MediumInterval);
+            if (std::isnormal(h60)) {
+                state.baseline = state.samples < kWarmup ? state.baseline + (h60 - state.baseline) / (state.samples + 1) : state.baseline + (h60 - state.baseline) * 0.05;
+                state.samples  = std::min(state.samples + 1, kWarmup);
+            }
+
+            continue;
+        }
+
+        if (++state.low == kConfirm) {
+            state.degraded = true;
+
+            LOG_WARN("%s " YELLOW("thread ") YELLOW_BOLD("#%zu") YELLOW(" is degraded, 10s hashrate is %.0f%% of its baseline and %.0f%% of the median"),
+                     m_tag, i, h * 100.0 / state.baseline, h * 100.0 / median);
+        }
+
+        if (m_restart && state.low >= kRestartAfter && state.restarts < kMaxRestarts && (state.lastRestart == 0 || now - state.lastRestart >= kRestartCooldown)) {
+            restart.push_back(i);
+        }
+    }
+
+    return restart;
+}
+
+
+// Kept threads keep their baseline and restart history, new threads start with a warmup
+void xmrig::HashrateWatchdog::remap(const std::vector<int64_t> &sources)
+{
+    std::vector<State> threads(sources.size());
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] >= 0 && static_cast<size_t>(sources[i]) < m_threads.size()) {
+            threads[i] = m_threads[static_cast<size_t>(sources[i])];
+        }
+    }
+
+    m_threads = std::move(threads);
+}
+
+
+void xmrig::HashrateWatchdog::restarted(size_t index, uint64_t now)
+{
+    if (index >= m_threads.size()) {
+        return;
+    }
+
+    State &state = m_threads[index];
+
+    LOG_WARN("%s " YELLOW("thread ") YELLOW_BOLD("#%zu") YELLOW(" recreated by watchdog (%u/%u)"), m_tag, index, state.restarts + 1, kMaxRestarts);
+
+    state.grace         = kGrace;
+    state.low           = 0;
+    state.lastRestart   = now;
+    state.restarts++;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::HashrateWatchdog::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    uint64_t restarts = 0;
+    Value degraded(kArrayType);
+
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        restarts += m_threads[i].restarts;
+
+        if (m_threads[i].degraded) {
+            degraded.PushBack(static_cast<uint64_t>(i), allocator);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("threshold",  m_threshold, allocator);
+    out.AddMember("restart",    m_restart, allocator);
+    out.AddMember("degraded",   degraded, allocator);
+    out.AddMember("restarts",   restarts, allocator);
+
+    return out;
+}
+
+
+rapidjson::Value xmrig::HashrateWatchdog::toJSON(size_t index, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    const State &state = m_threads[index];
+    const char *status = state.grace > 0 ? "restarted" : (state.samples < kWarmup ? "warmup" : (state.degraded ? "degraded" : "ok"));
+
+    Value out(kObjectType);
+    out.AddMember("status",     StringRef(status), allocator);
+    out.AddMember("baseline",   Hashrate::normalize(state.baseline), allocator);
+    out.AddMember("ratio",      state.samples >= kWarmup && state.baseline > 0.0 ? Hashrate::normalize(state.last / state.baseline) : Value(kNullType), allocator);
+    out.AddMember("restarts",   state.restarts, allocator);
+
+    return out;
+}
+#endif
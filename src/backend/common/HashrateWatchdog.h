@@ -0,0 +1,89 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_HASHRATEWATCHDOG_H
+#define XMRIG_HASHRATEWATCHDOG_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class Hashrate;
+
+
+/**
+ * Finds threads which hash slower than they used to and slower than their siblings.
+ *
+ * Every thread learns its own baseline from the 60s hashrate while it is healthy. A thread is an outlier when its
+ * 10s hashrate is below the threshold of both its baseline and the median of all threads, so a package wide
+ * slowdown (thermal limit, job with a slow GhostRider rotation) or a slower core type is not reported.
+ */
+class HashrateWatchdog
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(HashrateWatchdog)
+
+    HashrateWatchdog(const char *tag, size_t threads, uint32_t threshold, bool restart);
+
+    inline bool isEnabled() const       { return m_threshold > 0; }
+    inline uint32_t threshold() const   { return m_threshold; }
+
+    size_t degraded() const;
+    std::vector<size_t> check(const Hashrate &hashrate, uint64_t now);
+    void remap(const std::vector<int64_t> &sources);
+    void restarted(size_t index, uint64_t now);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    rapidjson::Value toJSON(size_t index, rapidjson::Document &doc) const;
+#   endif
+
+private:
+    struct State
+    {
+        bool degraded           = false;
+        double baseline         = 0.0;
+        double last             = 0.0;
+        uint32_t grace          = 0;
+        uint32_t low            = 0;
+        uint32_t restarts       = 0;
+        uint32_t samples        = 0;
+        uint64_t lastRestart    = 0;
+    };
+
+    const bool m_restart;
+    const char *m_tag;
+    const uint32_t m_threshold;
+    std::vector<State> m_threads;
+    uint64_t m_lastCheck        = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_HASHRATEWATCHDOG_H */
@@ -23,6 +23,7 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <atomic>
 #include <thread>
 
 
@@ -47,7 +48,15 @@ public:
     inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
 
 #   ifdef XMRIG_OS_APPLE
-    inline ~Thread() { pthread_join(m_thread, nullptr); delete m_worker; }
+    inline ~Thread() { join(); delete m_worker.load(); }
+
+    inline void join()
+    {
+        if (m_thread) {
+            pthread_join(m_thread, nullptr);
+            m_thread = nullptr;
+        }
+    }
 
     inline void start(void *(*callback)(void *))
     {
@@ -65,22 +74,39 @@ public:
         }
     }
 #   else
-    inline ~Thread() { m_thread.join(); delete m_worker; }
+    inline ~Thread() { join(); delete m_worker.load(); }
 
+    inline void join()                              { if (m_thread.joinable()) { m_thread.join(); } }
     inline void start(void *(*callback)(void *))    { m_thread = std::thread(callback, this); }
 #   endif
 
+    inline bool isRestart() const                   { return m_restart; }
+    inline bool isStopped() const                   { return m_stopped; }
     inline const T &config() const                  { return m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
     inline size_t id() const                        { return m_id; }
+    inline void setRestart()                        { m_restart = true; }
     inline void setWorker(IWorker *worker)          { m_worker = worker; }
 
+    // Asks this thread alone to finish, the worker may still be in self-test so onReady() checks isStopped() after setWorker().
+    inline void stop()
+    {
+        m_stopped = true;
+
+        IWorker *worker = m_worker;
+        if (worker) {
+            worker->stop();
+        }
+    }
+
 private:
     const size_t m_id    = 0;
     const T m_config;
     IBackend *m_backend;
-    IWorker *m_worker       = nullptr;
+    bool m_restart                      = false;
+    std::atomic<bool> m_stopped         = { false };
+    std::atomic<IWorker *> m_worker     = { nullptr };
 
     #ifdef XMRIG_OS_APPLE
     pthread_t m_thread{};
@@ -23,6 +23,9 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <atomic>
+
+
 namespace xmrig {
 
 
@@ -32,8 +35,10 @@ public:
     Worker(size_t id, int64_t affinity, int priority);
 
     size_t threads() const override                         { return 1; }
+    void stop() override                                    { m_stopped = true; }
 
 protected:
+    inline bool isStopped() const                           { return m_stopped.load(std::memory_order_relaxed); }
     inline int64_t affinity() const                         { return m_affinity; }
     inline size_t id() const override                       { return m_id; }
     inline uint32_t node() const                            { return m_node; }
@@ -43,6 +48,7 @@ protected:
 private:
     const int64_t m_affinity;
     const size_t m_id;
+    std::atomic<bool> m_stopped     = { false };
     uint32_t m_node                 = 0;
 };
 
@@ -18,13 +18,20 @@
 
 #include "backend/common/Workers.h"
 #include "backend/common/Hashrate.h"
+#include "backend/common/HashrateWatchdog.h"
 #include "backend/common/interfaces/IBackend.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Startup.h"
+#include "base/tools/Baton.h"
 #include "base/tools/Chrono.h"
 
 
+#include <algorithm>
+#include <uv.h>
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 #   include "backend/opencl/OclWorker.h"
 #endif
@@ -40,9 +47,30 @@
 #endif
 
 
+#ifdef XMRIG_MINER_PROJECT
+#   include "crypto/common/ScratchpadPool.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_HTTP
+#   include "3rdparty/rapidjson/document.h"
+#   include "base/api/EventStream.h"
+#endif
+
+
 namespace xmrig {
 
 
+// Hashes a stopped thread made after it was accounted, known once the thread is joined
+struct JoinedHashes
+{
+    size_t id;
+    bool removed;
+    uint64_t hashCount;
+    uint64_t rawHashes;
+};
+
+
 class WorkersPrivate
 {
 public:
@@ -51,12 +79,89 @@ public:
     WorkersPrivate()    = default;
     ~WorkersPrivate()   = default;
 
+    bool restart        = false;
     IBackend *backend   = nullptr;
     std::shared_ptr<Benchmark> benchmark;
     std::shared_ptr<Hashrate> hashrate;
+    std::shared_ptr<HashrateWatchdog> watchdog;
+    std::shared_ptr<std::vector<JoinedHashes> > joined = std::make_shared<std::vector<JoinedHashes> >();
+    std::vector<uint64_t> hashOffsets;     // hashes of recreated workers, keeps the counters of a position monotonic
+    std::vector<uint64_t> rawOffsets;
+    uint64_t removedRaw     = 0;       // hashes of threads removed by reconcile(), keeps the total monotonic
+    uint32_t threshold  = 0;
+    uint64_t lastHashCount  = 0;
+    uint64_t lastTs         = 0;
+};
+
+
+// Joining a stopped thread waits for its current round (self-test or a slow hash), done on the libuv thread pool.
+// The counters read when the thread was stopped are replaced by the final ones, tick() accounts the difference.
+template<class T>
+class JoinBaton : public Baton<uv_work_t>
+{
+public:
+    inline JoinBaton(std::vector<Thread<T> *> &&threads, std::vector<JoinedHashes> &&hashes, const std::shared_ptr<std::vector<JoinedHashes> > &joined, bool restart) :
+        restart(restart),
+        joined(joined),
+        threads(std::move(threads)),
+        hashes(std::move(hashes))
+    {}
+
+    const bool restart;
+    std::shared_ptr<std::vector<JoinedHashes> > joined;
+    std::vector<Thread<T> *> threads;
+    std::vector<JoinedHashes> hashes;
 };
 
 
+template<class T>
+static void join(std::vector<Thread<T> *> &&threads, std::vector<JoinedHashes> &&hashes, const std::shared_ptr<std::vector<JoinedHashes> > &joined, bool restart)
+{
+    if (threads.empty()) {
+        return;
+    }
+
+    auto baton = new JoinBaton<T>(std::move(threads), std::move(hashes), joined, restart);
+
+    uv_queue_work(uv_default_loop(), &baton->req,
+        [](uv_work_t *req) {
+            auto baton = static_cast<JoinBaton<T>*>(req->data);
+
+            for (size_t i = 0; i < baton->threads.size(); ++i) {
+                Thread<T> *handle = baton->threads[i];
+                handle->join();
+
+                uint64_t hashCount = 0;
+                uint64_t ts        = 0;
+                uint64_t rawHashes = 0;
+
+                if (handle->worker()) {
+                    handle->worker()->hashrateData(hashCount, ts, rawHashes);
+                }
+
+                baton->hashes[i].hashCount = hashCount - std::min(hashCount, baton->hashes[i].hashCount);
+                baton->hashes[i].rawHashes = rawHashes - std::min(rawHashes, baton->hashes[i].rawHashes);
+
+                delete handle;
+            }
+        },
+        [](uv_work_t *req, int) {
+            auto baton = static_cast<JoinBaton<T>*>(req->data);
+            baton->joined->insert(baton->joined->end(), baton->hashes.begin(), baton->hashes.end());
+
+#           ifdef XMRIG_MINER_PROJECT
+            // The scratchpad of a degraded worker is not handed to other workers
+            if (baton->restart && T::backend() == Nonce::CPU) {
+                ScratchpadPool::clear();
+            }
+#           endif
+
+            delete baton;
+        }
+    );
+}
+
+
 } // namespace xmrig
 
 
@@ -82,28 +187,83 @@ bool xmrig::Workers<T>::tick(uint64_t)
         return true;
     }
 
+    // Restarted threads keep adding to their position, hashes of removed ones count only in the total
+    for (const JoinedHashes &joined : *d_ptr->joined) {
+        size_t i = 0;
+        while (!joined.removed && i < m_workers.size() && m_workers[i]->id() != joined.id) {
+            ++i;
+        }
+
+        if (joined.removed || i == m_workers.size()) {
+            d_ptr->removedRaw += joined.rawHashes;
+            continue;
+        }
+
+        d_ptr->hashOffsets[i] += joined.hashCount;
+        d_ptr->rawOffsets[i]  += joined.rawHashes;
+    }
+
+    d_ptr->joined->clear();
+
     uint64_t ts             = Chrono::steadyMSecs();
     bool totalAvailable     = true;
+    bool allHashing         = !m_workers.empty();
     uint64_t totalHashCount = 0;
     uint64_t hashCount      = 0;
     uint64_t rawHashes      = 0;
 
-    for (Thread<T> *handle : m_workers) {
-        IWorker *worker = handle->worker();
+    // Hashrate is indexed by position, thread ids are not contiguous after reconcile()
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        IWorker *worker = m_workers[i]->worker();
         if (worker) {
             worker->hashrateData(hashCount, ts, rawHashes);
-            d_ptr->hashrate->add(handle->id(), hashCount, ts);
+            d_ptr->hashrate->add(i, hashCount + d_ptr->hashOffsets[i], ts);
 
             if (rawHashes == 0) {
                 totalAvailable = false;
+                allHashing     = false;
             }
 
-            totalHashCount += rawHashes;
+            totalHashCount += rawHashes + d_ptr->rawOffsets[i];
+        }
+        else {
+            allHashing = false;
         }
     }
 
+    totalHashCount += d_ptr->removedRaw;
+
     if (totalAvailable) {
         d_ptr->hashrate->add(totalHashCount, Chrono::steadyMSecs());
+
+        if (allHashing && !Startup::isComplete()) {
+            Startup::complete("hashrate");
+
+            LOG_INFO("%s " WHITE_BOLD("all threads are hashing, startup took ") CYAN_BOLD("%.3f s"), T::tag(), Startup::elapsed() / 1000.0);
+        }
+
+#       ifdef XMRIG_FEATURE_HTTP
+        if (EventStream::isActive() && d_ptr->lastTs && totalHashCount >= d_ptr->lastHashCount) {
+            using namespace rapidjson;
+
+            Document doc(kObjectType);
+            auto &allocator = doc.GetAllocator();
+
+            doc.AddMember("backend",  d_ptr->backend ? d_ptr->backend->type().toJSON() : Value(kNullType), allocator);
+            doc.AddMember("hashes",   totalHashCount - d_ptr->lastHashCount, allocator);
+            doc.AddMember("ms",       ts - d_ptr->lastTs, allocator);
+            doc.AddMember("hashrate", Hashrate::normalize(d_ptr->hashrate->calc(Hashrate::ShortInterval)), allocator);
+
+            EventStream::publish("hashrate", doc);
+        }
+
+        d_ptr->lastHashCount = totalHashCount;
+        d_ptr->lastTs        = ts;
+#       endif
+    }
+
+    for (size_t i : d_ptr->watchdog->check(*d_ptr->hashrate, Chrono::steadyMSecs())) {
+        restart(i);
     }
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -121,6 +281,102 @@ const xmrig::Hashrate *xmrig::Workers<T>::hashrate() const
 }
 
 
+template<class T>
+const xmrig::HashrateWatchdog *xmrig::Workers<T>::watchdog() const
+{
+    return d_ptr->watchdog.get();
+}
+
+
+// Threads with identical launch data keep running with their memory and hashrate history, the others are stopped
+// and joined off the main loop. New threads are created but not started until startPending(), so the backend can
+// account the kept workers first.
+template<class T>
+std::vector<xmrig::IWorker *> xmrig::Workers<T>::reconcile(const std::vector<T> &data)
+{
+    std::vector<Thread<T> *> workers(data.size(), nullptr);
+    std::vector<Thread<T> *> removed;
+    std::vector<JoinedHashes> removedHashes;
+    std::vector<int64_t> sources(data.size(), -1);
+    std::vector<size_t> ids;
+
+    for (size_t position = 0; position < m_workers.size(); ++position) {
+        Thread<T> *handle = m_workers[position];
+        size_t i = 0;
+        for (; i < data.size(); ++i) {
+            if (!workers[i] && data[i] == handle->config()) {
+                break;
+            }
+        }
+
+        // Threads which are still in self-test or failed it are restarted too
+        if (i < data.size() && handle->worker()) {
+            workers[i] = handle;
+            sources[i] = static_cast<int64_t>(position);
+            ids.push_back(handle->id());
+
+            continue;
+        }
+
+        handle->stop();
+        removed.push_back(handle);
+        removedHashes.push_back({ handle->id(), true, 0, 0 });
+
+        if (handle->worker() && position < d_ptr->rawOffsets.size()) {
+            uint64_t ts = 0;
+
+            handle->worker()->hashrateData(removedHashes.back().hashCount, ts, removedHashes.back().rawHashes);
+            d_ptr->removedRaw += removedHashes.back().rawHashes + d_ptr->rawOffsets[position];
+        }
+    }
+
+    join(std::move(removed), std::move(removedHashes), d_ptr->joined, false);
+
+    std::vector<IWorker *> kept;
+    size_t id = 0;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (workers[i]) {
+            kept.push_back(workers[i]->worker());
+            continue;
+        }
+
+        while (std::find(ids.begin(), ids.end(), id) != ids.end()) {
+            ++id;
+        }
+
+        workers[i] = new Thread<T>(d_ptr->backend, id++, data[i]);
+        m_pending.push_back(workers[i]);
+    }
+
+    m_workers = std::move(workers);
+
+    if (!d_ptr->hashrate) {
+        reset();
+
+        return kept;
+    }
+
+    // Only the slots of changed threads start over, the total and the kept threads continue
+    std::vector<uint64_t> hashOffsets(data.size(), 0);
+    std::vector<uint64_t> rawOffsets(data.size(), 0);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (sources[i] >= 0) {
+            hashOffsets[i] = d_ptr->hashOffsets[static_cast<size_t>(sources[i])];
+            rawOffsets[i]  = d_ptr->rawOffsets[static_cast<size_t>(sources[i])];
+        }
+    }
+
+    d_ptr->hashOffsets = std::move(hashOffsets);
+    d_ptr->rawOffsets  = std::move(rawOffsets);
+    d_ptr->hashrate->remap(sources);
+    d_ptr->watchdog->remap(sources);
+
+    return kept;
+}
+
+
 template<class T>
 void xmrig::Workers<T>::setBackend(IBackend *backend)
 {
@@ -128,6 +384,33 @@ void xmrig::Workers<T>::setBackend(IBackend *backend)
 }
 
 
+template<class T>
+void xmrig::Workers<T>::setWatchdog(uint32_t threshold, bool restart)
+{
+    if (threshold == d_ptr->threshold && restart == d_ptr->restart) {
+        return;
+    }
+
+    d_ptr->threshold = threshold;
+    d_ptr->restart   = restart;
+
+    if (d_ptr->watchdog) {
+        d_ptr->watchdog = std::make_shared<HashrateWatchdog>(T::tag(), m_workers.size(), threshold, restart);
+    }
+}
+
+
+template<class T>
+void xmrig::Workers<T>::startPending()
+{
+    for (auto worker : m_pending) {
+        worker->start(Workers<T>::onReady);
+    }
+
+    m_pending.clear();
+}
+
+
 template<class T>
 void xmrig::Workers<T>::stop()
 {
@@ -139,6 +422,7 @@ void xmrig::Workers<T>::stop()
         delete worker;
     }
 
+    m_pending.clear();
     m_workers.clear();
 
 #   ifdef XMRIG_MINER_PROJECT
@@ -146,6 +430,7 @@ void xmrig::Workers<T>::stop()
 #   endif
 
     d_ptr->hashrate.reset();
+    d_ptr->watchdog.reset();
 }
 
 
@@ -177,13 +462,21 @@ void *xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
+    Startup::begin("workers");
+
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
-    if (!worker || !worker->selfTest()) {
+    const bool ok = worker && worker->selfTest();
+    Startup::end("workers");
+
+    if (!ok) {
         LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" self-test failed"), T::tag(), worker ? worker->id() : 0);
 
-        handle->backend()->start(worker, false);
+        if (!handle->isStopped() && !handle->isRestart()) {
+            handle->backend()->start(worker, false);
+        }
+
         delete worker;
 
         return nullptr;
@@ -192,12 +485,70 @@ void *xmrig::Workers<T>::onReady(void *arg)
     assert(handle->backend() != nullptr);
 
     handle->setWorker(worker);
+
+    // Dropped by reconcile() while in self-test, the launch status was already reset for the new set of threads
+    if (handle->isStopped()) {
+        return nullptr;
+    }
+
+    // Recreated by the watchdog, the launch status still counts the previous worker
+    if (handle->isRestart()) {
+        worker->start();
+
+        return nullptr;
+    }
+
     handle->backend()->start(worker, true);
 
     return nullptr;
 }
 
 
+template<class T>
+void xmrig::Workers<T>::reset()
+{
+    d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+    d_ptr->watchdog = std::make_shared<HashrateWatchdog>(T::tag(), m_workers.size(), d_ptr->threshold, d_ptr->restart);
+
+    d_ptr->hashOffsets.assign(m_workers.size(), 0);
+    d_ptr->rawOffsets.assign(m_workers.size(), 0);
+    d_ptr->removedRaw = 0;
+    d_ptr->joined     = std::make_shared<std::vector<JoinedHashes> >();
+}
+
+
+// The new worker gets fresh memory: the old scratchpad is not handed back, it may be the reason of the slowdown.
+template<class T>
+void xmrig::Workers<T>::restart(size_t index)
+{
+    Thread<T> *handle = m_workers[index];
+    IWorker *worker   = handle->worker();
+    if (!worker) {
+        return;
+    }
+
+    handle->stop();
+
+    uint64_t hashCount = 0;
+    uint64_t ts        = 0;
+    uint64_t rawHashes = 0;
+
+    worker->hashrateData(hashCount, ts, rawHashes);
+    d_ptr->hashOffsets[index] += hashCount;
+    d_ptr->rawOffsets[index]  += rawHashes;
+
+    auto replacement = new Thread<T>(d_ptr->backend, handle->id(), handle->config());
+    replacement->setRestart();
+
+    join<T>({ handle }, { { handle->id(), false, hashCount, rawHashes } }, d_ptr->joined, true);
+
+    m_workers[index] = replacement;
+    replacement->start(Workers<T>::onReady);
+
+    d_ptr->watchdog->restarted(index, Chrono::steadyMSecs());
+}
+
+
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
 {
@@ -205,7 +556,7 @@ void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
         m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
     }
 
-    d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+    reset();
 
 #   ifdef XMRIG_MINER_PROJECT
     Nonce::touch(T::backend());
@@ -42,6 +42,7 @@ namespace xmrig {
 
 class Benchmark;
 class Hashrate;
+class HashrateWatchdog;
 class WorkersPrivate;
 
 
@@ -58,8 +59,12 @@ public:
 
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
+    const HashrateWatchdog *watchdog() const;
+    std::vector<IWorker *> reconcile(const std::vector<T> &data);
     void jobEarlyNotification(const Job &job);
     void setBackend(IBackend *backend);
+    void setWatchdog(uint32_t threshold, bool restart);
+    void startPending();
     void stop();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -70,8 +75,11 @@ private:
     static IWorker *create(Thread<T> *handle);
     static void *onReady(void *arg);
 
+    void reset();
+    void restart(size_t index);
     void start(const std::vector<T> &data, bool sleep);
 
+    std::vector<Thread<T> *> m_pending;
     std::vector<Thread<T> *> m_workers;
     WorkersPrivate *d_ptr;
 };
@@ -0,0 +1,471 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/common/benchmark/BenchSuite.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/kernel/Platform.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+#include "version.h"
+
+
+#ifdef XMRIG_ALGO_ARGON2
+#   include "crypto/argon2/Impl.h"
+#endif
+
+#ifdef XMRIG_ALGO_ASTROBWT
+#   include "crypto/astrobwt/AstroBWT.h"
+#endif
+
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "crypto/ghostrider/ghostrider.h"
+#endif
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+
+namespace xmrig {
+
+
+static constexpr size_t kRxBlobSize     = 112;
+static constexpr uint64_t kHeight       = 1;
+static constexpr int kAstroBWTMaxSize   = 550 * 1000;  // CpuConfig default
+
+
+struct BenchSuiteSync
+{
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+};
+
+
+struct BenchSuiteThread
+{
+    HugePagesInfo pages;
+    uint64_t hashes = 0;
+};
+
+
+struct BenchSuiteProfile
+{
+    const char *name;
+    CpuThreads threads;
+};
+
+
+// Same mapping as CpuLaunchData::av().
+static CnHash::AlgoVariant variant(uint32_t ways, bool hwAES)
+{
+    if (ways == 8) {
+        return !hwAES ? CnHash::AV_OCTA_SOFT : CnHash::AV_OCTA;
+    }
+
+    if (ways <= 2) {
+        return static_cast<CnHash::AlgoVariant>(!hwAES ? (ways + 2) : ways);
+    }
+
+    return static_cast<CnHash::AlgoVariant>(!hwAES ? (ways + 5) : (ways + 2));
+}
+
+
+static uint32_t ways(const Algorithm &algorithm, const CpuThread &thread, uint32_t av)
+{
+    switch (algorithm.family()) {
+    case Algorithm::RANDOM_X:
+    case Algorithm::ARGON2:
+    case Algorithm::ASTROBWT:
+        return 1;
+
+    case Algorithm::GHOSTRIDER:
+        return 8;
+
+    default:
+        break;
+    }
+
+    return av ? av : thread.intensity();
+}
+
+
+static bool isSupported(const Algorithm &algorithm, uint32_t ways)
+{
+    switch (algorithm.family()) {
+    case Algorithm::RANDOM_X:
+    case Algorithm::ASTROBWT:
+    case Algorithm::GHOSTRIDER:
+        return true;
+
+    default:
+        break;
+    }
+
+    return CnHash::fn(algorithm, variant(ways, Cpu::info()->hasAES()), Assembly::AUTO) != nullptr;
+}
+
+
+static void worker(const Algorithm &algorithm, const CpuThread &thread, uint32_t ways, RxDataset *dataset, BenchSuiteSync &sync, BenchSuiteThread &out)
+{
+    Platform::trySetThreadAffinity(thread.affinity());
+
+    const auto family       = algorithm.family();
+    const bool hwAES        = Cpu::info()->hasAES();
+    const size_t size       = family == Algorithm::RANDOM_X ? kRxBlobSize : (family == Algorithm::GHOSTRIDER ? 80 : 76);
+    const size_t nonceOffset = family == Algorithm::GHOSTRIDER ? 76 : 39;
+
+    VirtualMemory memory(algorithm.l3() * ways, true, false, false);
+    out.pages = memory.hugePages();
+
+    std::vector<uint8_t> blob(size * ways, 0);
+    alignas(16) uint8_t hash[8 * 32];
+
+    // Valid rotation bytes, same as the GhostRider self-test
+    for (size_t i = 0; family == Algorithm::GHOSTRIDER && i < ways; ++i) {
+        blob[i * size + 4] = 0x10;
+        blob[i * size + 5] = 0x02;
+    }
+
+    auto wait = [&sync]() {
+        ++sync.ready;
+
+        while (!sync.go.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    if (family == Algorithm::RANDOM_X) {
+        randomx_vm *vm = RxVm::create(dataset, memory.scratchpad(), !hwAES, Assembly::AUTO, 0);
+        uint64_t tempHash[8];
+
+        wait();
+
+        randomx_calculate_hash_first(vm, tempHash, blob.data(), size);
+
+        for (uint32_t nonce = 1; !sync.stop.load(std::memory_order_relaxed); ++nonce) {
+            memcpy(blob.data() + nonceOffset, &nonce, sizeof(nonce));
+            randomx_calculate_hash_next(vm, tempHash, blob.data(), size, hash);
+            ++out.hashes;
+        }
+
+        RxVm::destroy(vm);
+
+        return;
+    }
+
+    cryptonight_ctx *ctx[8] = {};
+    CnCtx::create(ctx, memory.scratchpad(), algorithm.l3(), ways);
+
+    const cn_hash_fun fn = CnHash::fn(algorithm, variant(ways, hwAES), Assembly::AUTO);
+
+#   ifdef XMRIG_ALGO_ASTROBWT
+    const bool avx2      = Cpu::info()->hasAVX2();
+#   endif
+
+    wait();
+
+    for (uint32_t nonce = 0; !sync.stop.load(std::memory_order_relaxed); nonce += ways) {
+        for (uint32_t i = 0; i < ways; ++i) {
+            const uint32_t value = nonce + i;
+            memcpy(blob.data() + i * size + nonceOffset, &value, sizeof(value));
+        }
+
+        switch (family) {
+#       ifdef XMRIG_ALGO_ASTROBWT
+        case Algorithm::ASTROBWT:
+            out.hashes += astrobwt::astrobwt_dero(blob.data(), size, ctx[0]->memory, hash, kAstroBWTMaxSize, avx2) ? 1 : 0;
+            break;
+#       endif
+
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        case Algorithm::GHOSTRIDER:
+            ghostrider::hash_octa(blob.data(), size, hash, ctx, nullptr, false);
+            out.hashes += ways;
+            break;
+#       endif
+
+        default:
+            fn(blob.data(), size, hash, ctx, kHeight);
+            out.hashes += ways;
+            break;
+        }
+    }
+
+    CnCtx::release(ctx, ways);
+}
+
+
+static std::vector<BenchSuiteProfile> profiles(const Algorithm &algorithm)
+{
+    std::vector<BenchSuiteProfile> out;
+    out.push_back({ "auto", Cpu::info()->threads(algorithm, 100) });
+
+    const auto half = Cpu::info()->threads(algorithm, 50);
+    if (half.count() > 0 && half.count() < out.front().threads.count()) {
+        out.push_back({ "half", half });
+    }
+
+    if (out.front().threads.count() > 1) {
+        CpuThreads single;
+        single.add(out.front().threads.data().front());
+
+        out.push_back({ "single", single });
+    }
+
+    return out;
+}
+
+
+// 0 means the intensity from the thread profile, CryptoNight variants are also measured with forced 1 and 2 ways.
+static std::vector<uint32_t> avSettings(const Algorithm &algorithm)
+{
+    if (algorithm.family() == Algorithm::CN || algorithm.family() == Algorithm::CN_HEAVY) {
+        return { 0, 1, 2 };
+    }
+
+    return { 0 };
+}
+
+
+static rapidjson::Value stats(rapidjson::Document &doc, const std::vector<double> &values)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    double mean = 0.0;
+    for (double v : values) {
+        mean += v;
+    }
+
+    mean /= values.size();
+
+    double variance = 0.0;
+    for (double v : values) {
+        variance += (v - mean) * (v - mean);
+    }
+
+    Value runs(kArrayType);
+    for (double v : values) {
+        runs.PushBack(v, allocator);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("mean",   mean, allocator);
+    out.AddMember("stddev", values.size() > 1 ? std::sqrt(variance / (values.size() - 1)) : 0.0, allocator);
+    out.AddMember("min",    *std::min_element(values.begin(), values.end()), allocator);
+    out.AddMember("max",    *std::max_element(values.begin(), values.end()), allocator);
+    out.AddMember("runs",   runs, allocator);
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+int xmrig::BenchSuite::exec(const std::vector<Algorithm> &algorithms, uint32_t repeats, uint32_t time, const String &fileName)
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("version",    APP_VERSION, allocator);
+    doc.AddMember("cpu",        Cpu::info()->toJSON(doc), allocator);
+    doc.AddMember("repeats",    repeats, allocator);
+    doc.AddMember("time",       time, allocator);
+
+    Value results(kArrayType);
+    bool failed = false;
+
+#   ifdef XMRIG_ALGO_ARGON2
+    argon2::Impl::select(String());
+#   endif
+
+#   ifdef XMRIG_ALGO_ASTROBWT
+    astrobwt::init();
+#   endif
+
+    printf("%-16s %-8s %7s %4s %12s %10s %8s %9s %9s\n", "ALGO", "PROFILE", "THREADS", "AV", "H/s", "STDDEV", "HUGE", "STARTUP", "DATASET");
+
+    for (const Algorithm &algorithm : algorithms) {
+        RxDataset *dataset      = nullptr;
+        uint64_t datasetTime    = 0;
+        HugePagesInfo datasetPages;
+
+        if (algorithm.family() == Algorithm::RANDOM_X) {
+            const uint64_t ts = Chrono::steadyMSecs();
+
+            RxAlgo::apply(algorithm);
+
+            dataset = new RxDataset(true, false, true, RxConfig::FastMode, 0);
+            if (!dataset->cache()->get() || !dataset->init(Buffer(Job::kMaxSeedSize, 0), static_cast<uint32_t>(Cpu::info()->threads()), -1)) {
+                printf("%-16s failed to allocate RandomX memory\n", algorithm.name());
+                delete dataset;
+                failed = true;
+
+                continue;
+            }
+
+            datasetTime  = Chrono::steadyMSecs() - ts;
+            datasetPages = dataset->hugePages();
+        }
+
+        for (const auto &profile : profiles(algorithm)) {
+            const size_t count = profile.threads.count();
+
+            for (uint32_t av : avSettings(algorithm)) {
+                if (count == 0 || !isSupported(algorithm, ways(algorithm, profile.threads.data().front(), av))) {
+                    continue;
+                }
+
+                std::vector<double> hashrates;
+                std::vector<double> startups;
+                HugePagesInfo pages;
+
+                for (uint32_t r = 0; r < repeats; ++r) {
+                    BenchSuiteSync sync;
+                    std::vector<BenchSuiteThread> out(count);
+                    std::vector<std::thread> threads;
+                    threads.reserve(count);
+
+                    const uint64_t ts = Chrono::steadyMSecs();
+
+                    for (size_t i = 0; i < count; ++i) {
+                        const CpuThread &thread = profile.threads.data()[i];
+
+                        threads.emplace_back(worker, std::cref(algorithm), std::cref(thread), ways(algorithm, thread, av), dataset, std::ref(sync), std::ref(out[i]));
+                    }
+
+                    while (sync.ready.load() < count) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+
+                    const uint64_t start = Chrono::steadyMSecs();
+                    sync.go.store(true, std::memory_order_release);
+
+                    std::this_thread::sleep_for(std::chrono::seconds(time));
+
+                    sync.stop = true;
+                    const uint64_t elapsed = std::max<uint64_t>(Chrono::steadyMSecs() - start, 1);
+
+                    for (auto &thread : threads) {
+                        thread.join();
+                    }
+
+                    uint64_t hashes = 0;
+                    pages           = datasetPages;
+
+                    for (const auto &thread : out) {
+                        hashes += thread.hashes;
+                        pages  += thread.pages;
+                    }
+
+                    hashrates.emplace_back(static_cast<double>(hashes) * 1000.0 / elapsed);
+                    startups.emplace_back(static_cast<double>(start - ts));
+                }
+
+                Value result(kObjectType);
+                result.AddMember("algo",        algorithm.toJSON(), allocator);
+                result.AddMember("profile",     StringRef(profile.name), allocator);
+                result.AddMember("threads",     static_cast<uint64_t>(count), allocator);
+                result.AddMember("av",          av ? Value(av) : Value("auto"), allocator);
+                result.AddMember("hashrate",    stats(doc, hashrates), allocator);
+
+                Value hugepages(kArrayType);
+                hugepages.PushBack(static_cast<uint64_t>(pages.allocated), allocator);
+                hugepages.PushBack(static_cast<uint64_t>(pages.total), allocator);
+
+                result.AddMember("hugepages",   hugepages, allocator);
+                result.AddMember("startup",     stats(doc, startups), allocator);
+                result.AddMember("dataset",     dataset ? Value(datasetTime) : Value(kNullType), allocator);
+
+                results.PushBack(result, allocator);
+
+                const auto &hashrate = results[results.Size() - 1]["hashrate"];
+                failed |= hashrate["min"].GetDouble() <= 0.0;
+
+                printf("%-16s %-8s %7zu %4s %12.1f %10.1f %7.0f%% %7.0fms %7" PRIu64 "ms\n",
+                       algorithm.name(),
+                       profile.name,
+                       count,
+                       av ? std::to_string(av).c_str() : "auto",
+                       hashrate["mean"].GetDouble(),
+                       hashrate["stddev"].GetDouble(),
+                       pages.percent(),
+                       results[results.Size() - 1]["startup"]["mean"].GetDouble(),
+                       datasetTime
+                       );
+            }
+        }
+
+        delete dataset;
+    }
+
+    doc.AddMember("results", results, allocator);
+
+    if (!Json::save(fileName, doc)) {
+        printf("failed to save benchmark report to \"%s\"\n", fileName.data());
+
+        return 1;
+    }
+
+    printf("benchmark report saved to \"%s\"\n", fileName.data());
+
+    return failed ? 1 : 0;
+}
+
+
+std::vector<xmrig::Algorithm> xmrig::BenchSuite::algorithms()
+{
+    return {
+        Algorithm::RX_0,
+        Algorithm::RX_WOW,
+        Algorithm::CN_R,
+#       ifdef XMRIG_ALGO_CN_HEAVY
+        Algorithm::CN_HEAVY_0,
+#       endif
+#       ifdef XMRIG_ALGO_ARGON2
+        Algorithm::AR2_CHUKWA,
+#       endif
+#       ifdef XMRIG_ALGO_ASTROBWT
+        Algorithm::ASTROBWT_DERO,
+#       endif
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        Algorithm::GHOSTRIDER_RTM,
+#       endif
+    };
+}
@@ -0,0 +1,49 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BENCHSUITE_H
+#define XMRIG_BENCHSUITE_H
+
+
+#include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Offline benchmark matrix: every algorithm runs with every thread profile and AV setting several times,
+// the hashrate statistics, huge pages coverage and setup times are written as a JSON report.
+class BenchSuite
+{
+public:
+    static constexpr uint32_t kRepeats  = 3;
+    static constexpr uint32_t kTime     = 10;
+
+    static int exec(const std::vector<Algorithm> &algorithms, uint32_t repeats, uint32_t time, const String &fileName);
+    static std::vector<Algorithm> algorithms();
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_BENCHSUITE_H */
@@ -0,0 +1,281 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/common/benchmark/CoreHealth.h"
+#include "backend/common/benchmark/BenchState.h"
+#include "backend/cpu/Cpu.h"
+#include "base/kernel/Platform.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/cn/CryptoNight_test.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Same input as the embedded benchmark (BenchClient): 112 zero bytes, zero seed, 32-bit nonce at offset 39.
+static constexpr size_t kBlobSize       = 112;
+static constexpr size_t kNonceOffset    = 39;
+
+
+struct CoreHealthCpu
+{
+    int32_t id          = -1;
+    uint32_t cnErrors   = 0;
+    uint32_t rxErrors   = 0;
+    uint64_t hashes     = 0;
+    uint64_t time       = 0;
+};
+
+
+struct CnVector
+{
+    Algorithm::Id algorithm;
+    const uint8_t *reference;
+};
+
+
+static const CnVector cnVectors[] = {
+    { Algorithm::CN_0,          test_output_v0       },
+    { Algorithm::CN_1,          test_output_v1       },
+    { Algorithm::CN_2,          test_output_v2       },
+    { Algorithm::CN_HALF,       test_output_half     },
+    { Algorithm::CN_RWZ,        test_output_rwz      },
+    { Algorithm::CN_ZLS,        test_output_zls      },
+    { Algorithm::CN_DOUBLE,     test_output_double   },
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    { Algorithm::CN_HEAVY_0,    test_output_v0_heavy },
+#   endif
+};
+
+
+static uint32_t cnCheck(bool hwAES)
+{
+    const auto av = hwAES ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT;
+
+    size_t size = Algorithm(Algorithm::CN_R).l3();
+    for (const auto &v : cnVectors) {
+        size = std::max(size, Algorithm(v.algorithm).l3());
+    }
+
+    VirtualMemory memory(size, true, false, false);
+    cryptonight_ctx *ctx[1] = { nullptr };
+    CnCtx::create(ctx, memory.scratchpad(), size, 1);
+
+    alignas(16) uint8_t hash[32];
+    uint32_t errors = 0;
+
+    for (const auto &v : cnVectors) {
+        cn_hash_fun fn = CnHash::fn(v.algorithm, av, Assembly::AUTO);
+        if (!fn) {
+            continue;
+        }
+
+        fn(test_input, 76, hash, ctx, 0);
+        if (memcmp(hash, v.reference, sizeof(hash)) != 0) {
+            ++errors;
+        }
+    }
+
+    cn_hash_fun fn = CnHash::fn(Algorithm::CN_R, av, Assembly::AUTO);
+    for (size_t i = 0; fn && i < (sizeof(cn_r_test_input) / sizeof(cn_r_test_input[0])); ++i) {
+        fn(cn_r_test_input[i].data, cn_r_test_input[i].size, hash, ctx, cn_r_test_input[i].height);
+        if (memcmp(hash, test_output_r + i * 32, sizeof(hash)) != 0) {
+            ++errors;
+        }
+    }
+
+    CnCtx::release(ctx, 1);
+
+    return errors;
+}
+
+
+static void worker(RxDataset *dataset, const Algorithm &algorithm, CoreHealthCpu &cpu, uint32_t first, uint32_t last, uint64_t &sum)
+{
+    Platform::setThreadAffinity(static_cast<uint64_t>(cpu.id));
+
+    const bool hwAES = Cpu::info()->hasAES();
+
+    cpu.cnErrors += cnCheck(hwAES);
+
+    VirtualMemory memory(algorithm.l3(), true, false, false);
+    randomx_vm *vm = RxVm::create(dataset, memory.scratchpad(), !hwAES, Assembly::AUTO, 0);
+
+    alignas(16) uint8_t blob[kBlobSize]{};
+    alignas(16) uint8_t hash[32];
+    uint64_t value = 0;
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    for (uint32_t nonce = first; nonce < last; ++nonce) {
+        memcpy(blob + kNonceOffset, &nonce, sizeof(nonce));
+        randomx_calculate_hash(vm, blob, sizeof(blob), hash);
+
+        uint64_t v;
+        memcpy(&v, hash + 24, sizeof(v));
+        value ^= v;
+    }
+
+    cpu.time   += Chrono::steadyMSecs() - ts;
+    cpu.hashes += last - first;
+    sum         = value;
+
+    RxVm::destroy(vm);
+}
+
+
+// Block b of every round is known good if that round matched the reference, otherwise the value most rounds agree on.
+static bool expected(const std::vector<std::vector<uint64_t> > &sums, const std::vector<bool> &passed, size_t block, uint64_t &value)
+{
+    for (size_t r = 0; r < sums.size(); ++r) {
+        if (passed[r]) {
+            value = sums[r][block];
+
+            return true;
+        }
+    }
+
+    std::map<uint64_t, size_t> votes;
+    for (const auto &round : sums) {
+        if (++votes[round[block]] * 2 > sums.size()) {
+            value = round[block];
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+} // namespace xmrig
+
+
+int xmrig::CoreHealth::exec(const Algorithm &algorithm, uint32_t rounds)
+{
+    const uint64_t reference = BenchState::referenceHash(algorithm, kSize, 0);
+    if (reference == 0) {
+        printf("core health check supports rx/0 and rx/wow only\n");
+
+        return 1;
+    }
+
+    std::vector<CoreHealthCpu> cpus;
+    for (int32_t id : Cpu::info()->units()) {
+        CoreHealthCpu cpu;
+        cpu.id = id;
+        cpus.emplace_back(cpu);
+    }
+
+    const size_t count = cpus.size();
+    if (count == 0 || kSize < count) {
+        return 1;
+    }
+
+    printf("core health check: %s, %u hashes per round, %u rounds on %zu logical CPUs\n", algorithm.name(), kSize, rounds, count);
+
+    uint64_t ts = Chrono::steadyMSecs();
+
+    RxAlgo::apply(algorithm);
+
+    auto dataset = new RxDataset(true, false, true, RxConfig::FastMode, 0);
+    if (!dataset->cache()->get() || !dataset->init(Buffer(Job::kMaxSeedSize, 0), static_cast<uint32_t>(count), -1)) {
+        printf("failed to allocate RandomX memory\n");
+        delete dataset;
+
+        return 1;
+    }
+
+    printf("dataset %s, huge pages %1.0f%% (%" PRIu64 " ms)\n", dataset->get() ? "ready" : "unavailable, using light mode", dataset->hugePages().percent(), Chrono::steadyMSecs() - ts);
+
+    // Round r gives block (i + r) % count to CPU i, so over "count" rounds every CPU hashes every block.
+    std::vector<std::vector<uint64_t> > sums(rounds, std::vector<uint64_t>(count, 0));
+    std::vector<bool> passed(rounds, false);
+
+    for (uint32_t r = 0; r < rounds; ++r) {
+        ts = Chrono::steadyMSecs();
+
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const size_t block   = (i + r) % count;
+            const uint32_t first = static_cast<uint32_t>(kSize * block / count);
+            const uint32_t last  = static_cast<uint32_t>(kSize * (block + 1) / count);
+
+            threads.emplace_back(worker, dataset, std::cref(algorithm), std::ref(cpus[i]), first, last, std::ref(sums[r][block]));
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        uint64_t total = 0;
+        for (uint64_t value : sums[r]) {
+            total ^= value;
+        }
+
+        passed[r] = total == reference;
+
+        printf("round %u/%u hash sum %016" PRIX64 " %s (%.3f s)\n", r + 1, rounds, total, passed[r] ? "OK" : "MISMATCH", static_cast<double>(Chrono::steadyMSecs() - ts) / 1000.0);
+    }
+
+    delete dataset;
+
+    for (size_t block = 0; block < count; ++block) {
+        uint64_t value = 0;
+        const bool known = expected(sums, passed, block, value);
+
+        for (uint32_t r = 0; r < rounds; ++r) {
+            if (!passed[r] && (!known || sums[r][block] != value)) {
+                ++cpus[(block + count - r % count) % count].rxErrors;
+            }
+        }
+    }
+
+    printf("\n%6s %12s %10s %10s\n", "CPU", "H/s", "RandomX", "CN");
+
+    uint64_t errors = static_cast<uint64_t>(std::count(passed.begin(), passed.end(), false));
+    for (const auto &cpu : cpus) {
+        printf("%6d %12.1f %10u %10u\n", cpu.id, cpu.time ? static_cast<double>(cpu.hashes) * 1000.0 / cpu.time : 0.0, cpu.rxErrors, cpu.cnErrors);
+
+        errors += cpu.rxErrors + cpu.cnErrors;
+    }
+
+    printf("\ncore health check %s\n", errors ? "FAILED" : "PASSED");
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_COREHEALTH_H
+#define XMRIG_COREHEALTH_H
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+
+
+// Offline burn-in: every logical CPU in turn hashes every block of the benchmark nonce space at full load,
+// results are checked against the BenchState reference hashes and the CryptoNight known-answer vectors.
+class CoreHealth
+{
+public:
+    static constexpr uint32_t kSize     = 250000;
+    static constexpr uint32_t kRounds   = 3;
+
+    static int exec(const Algorithm &algorithm, uint32_t rounds);
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_COREHEALTH_H */
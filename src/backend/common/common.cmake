@@ -1,5 +1,6 @@
 set(HEADERS_BACKEND_COMMON
     src/backend/common/Hashrate.h
+    src/backend/common/HashrateWatchdog.h
     src/backend/common/Tags.h
     src/backend/common/interfaces/IBackend.h
     src/backend/common/interfaces/IRxListener.h
@@ -15,6 +16,7 @@ set(HEADERS_BACKEND_COMMON
 
 set(SOURCES_BACKEND_COMMON
     src/backend/common/Hashrate.cpp
+    src/backend/common/HashrateWatchdog.cpp
     src/backend/common/Threads.cpp
     src/backend/common/Worker.cpp
     src/backend/common/Workers.cpp
@@ -25,12 +27,16 @@ if (WITH_RANDOMX AND WITH_BENCHMARK)
         src/backend/common/benchmark/Benchmark.h
         src/backend/common/benchmark/BenchState_test.h
         src/backend/common/benchmark/BenchState.h
+        src/backend/common/benchmark/BenchSuite.h
+        src/backend/common/benchmark/CoreHealth.h
         src/backend/common/interfaces/IBenchListener.h
         )
 
     list(APPEND SOURCES_BACKEND_COMMON
         src/backend/common/benchmark/Benchmark.cpp
         src/backend/common/benchmark/BenchState.cpp
+        src/backend/common/benchmark/BenchSuite.cpp
+        src/backend/common/benchmark/CoreHealth.cpp
         )
 endif()
 
@@ -50,6 +50,7 @@ public:
     virtual void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const  = 0;
     virtual void jobEarlyNotification(const Job &job)                                               = 0;
     virtual void start()                                                                            = 0;
+    virtual void stop()                                                                             = 0;
 };
 
 
@@ -22,6 +22,7 @@
 
 #include "backend/cpu/Cpu.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/kernel/Startup.h"
 
 
 #if defined(XMRIG_FEATURE_HWLOC)
@@ -37,11 +38,15 @@ static xmrig::ICpuInfo *cpuInfo = nullptr;
 xmrig::ICpuInfo *xmrig::Cpu::info()
 {
     if (cpuInfo == nullptr) {
+        Startup::begin("cpu-info");
+
 #       if defined(XMRIG_FEATURE_HWLOC)
         cpuInfo = new HwlocCpuInfo();
 #       else
         cpuInfo = new BasicCpuInfo();
 #       endif
+
+        Startup::end("cpu-info");
     }
 
     return cpuInfo;
@@ -16,12 +16,15 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 
 
 #include "backend/cpu/CpuBackend.h"
 #include "3rdparty/rapidjson/document.h"
 #include "backend/common/Hashrate.h"
+#include "backend/common/HashrateWatchdog.h"
 #include "backend/common/interfaces/IWorker.h"
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
@@ -33,6 +36,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/ScratchpadPool.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -43,17 +47,49 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_ALGO_ARGON2
 #   include "crypto/argon2/Impl.h"
 #endif
 
 
+#ifdef XMRIG_ALGO_ASTROBWT
+#   include "crypto/astrobwt/AstroBWT.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "crypto/ghostrider/ghostrider.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_MSR
+#   include "crypto/rx/RxConfig.h"
+#   include "crypto/rx/RxMsrExplorer.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "crypto/rx/RxResctrl.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
 #endif
 
 
+#ifdef XMRIG_FEATURE_TELEMETRY
+#   include "hw/telemetry/CpuTelemetry.h"
+#   include "hw/telemetry/EfficiencyTuner.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -162,6 +198,56 @@ public:
     }
 
 
+    // Incremental restart is possible when at least one running thread keeps exactly the same launch data
+    inline bool canReconcile(const std::vector<CpuLaunchData> &next) const
+    {
+#       ifdef XMRIG_FEATURE_BENCHMARK
+        if (BenchState::size()) {
+            return false;
+        }
+#       endif
+
+        return std::any_of(next.begin(), next.end(), [this](const CpuLaunchData &data) {
+            return std::find(threads.begin(), threads.end(), data) != threads.end();
+        });
+    }
+
+
+    inline void reconcile(std::vector<CpuLaunchData> &&next)
+    {
+        const uint64_t ts     = Chrono::steadyMSecs();
+        const size_t previous = threads.size();
+
+        threads   = std::move(next);
+        auto kept = workers.reconcile(threads);
+
+        LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " kept " CYAN_BOLD("%zu") " stopped " CYAN_BOLD("%zu") " started " CYAN_BOLD("%zu") BLACK_BOLD(" (%" PRIu64 " ms)"),
+                 Tags::cpu(),
+                 profileName.data(),
+                 threads.size(),
+                 threads.size() > 1 ? "s" : "",
+                 kept.size(),
+                 previous - kept.size(),
+                 threads.size() - kept.size(),
+                 Chrono::steadyMSecs() - ts
+                 );
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            status.start(threads, algo.l3());
+
+            for (IWorker *worker : kept) {
+                if (status.started(worker, true)) {
+                    status.print();
+                }
+            }
+        }
+
+        workers.startPending();
+    }
+
+
     size_t ways() const
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -201,16 +287,131 @@ public:
     }
 
 
+    // Built once per profile and limit, the API requests it with every /2/backends call
+    const CpuPlan &currentPlan(uint32_t limit)
+    {
+        if (plan.algorithm() != algo || planLimit != limit) {
+            plan      = Cpu::info()->plan(algo, limit);
+            planLimit = limit;
+        }
+
+        return plan;
+    }
+
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    // Caps the profile to the operating point of the efficiency tuner, a new profile restarts the search
+    std::vector<CpuLaunchData> efficient(const CpuConfig &cpu, const Algorithm &algorithm, std::vector<CpuLaunchData> &&next)
+    {
+        bool enabled = cpu.isEfficiency() && !next.empty();
+
+#       ifdef XMRIG_FEATURE_BENCHMARK
+        enabled = enabled && !BenchState::size();
+#       endif
+
+        if (!enabled) {
+            efficiency.reset();
+            efficiencyProfile.clear();
+
+            return std::move(next);
+        }
+
+        if (!efficiency) {
+            efficiency = std::make_shared<EfficiencyTuner>(telemetry, cpu.isEfficiencyPowerLimit());
+        }
+
+        if (efficiencyProfile.size() != next.size() || !std::equal(efficiencyProfile.begin(), efficiencyProfile.end(), next.begin())) {
+            uint32_t intensity = 1;
+            for (const CpuLaunchData &data : next) {
+                intensity = std::max(intensity, data.intensity);
+            }
+
+            efficiency->reset(algorithm, static_cast<uint32_t>(next.size()), intensity);
+            efficiencyProfile = std::move(next);
+        }
+
+        return cpu.get(controller->miner(), algorithm, efficiency->current().threads, efficiency->current().intensity);
+    }
+#   endif
+
+
+#   ifdef XMRIG_FEATURE_MSR
+    // Exploration runs once per RandomX session, results stay available in the API
+    void explore()
+    {
+        const auto &rx = controller->config()->rx();
+        bool enabled   = rx.isMsrExplore() && algo.family() == Algorithm::RANDOM_X;
+
+#       ifdef XMRIG_FEATURE_BENCHMARK
+        enabled = enabled && !BenchState::size();
+#       endif
+
+        if (!enabled) {
+            if (msrExplorer && !msrExplorer->isDone()) {
+                msrExplorer.reset();
+            }
+
+            return;
+        }
+
+        if (!msrExplorer) {
+            msrExplorer = std::make_shared<RxMsrExplorer>(rx.msrPreset());
+        }
+    }
+#   endif
+
+
+    // Efficiency search waits for MSR exploration, both compare the hashrate over time
+    inline bool isExploring() const
+    {
+#       ifdef XMRIG_FEATURE_MSR
+        return msrExplorer && !msrExplorer->isDone();
+#       else
+        return false;
+#       endif
+    }
+
+
+    // Sum of per thread hashrate by core type, indexed by ICpuInfo::CoreType and then by interval
+    void coreTypeHashrate(size_t count[2], double total[2][3]) const
+    {
+        static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+        for (size_t i = 0; i < threads.size(); ++i) {
+            const auto type = Cpu::info()->coreType(threads[i].affinity);
+            count[type]++;
+
+            for (size_t k = 0; k < 3; ++k) {
+                const double h = workers.hashrate()->calc(i, intervals[k]);
+                total[type][k] += std::isnormal(h) ? h : 0.0;
+            }
+        }
+    }
+
+
     Algorithm algo;
     Controller *controller;
     CpuLaunchStatus status;
+    CpuPlan plan;
     std::vector<CpuLaunchData> threads;
     String profileName;
+    uint32_t planLimit      = 0;
     Workers<CpuLaunchData> workers;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     std::shared_ptr<Benchmark> benchmark;
 #   endif
+
+#   ifdef XMRIG_FEATURE_MSR
+    std::shared_ptr<RxMsrExplorer> msrExplorer;
+#   endif
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    CpuTelemetry telemetry;
+    std::shared_ptr<EfficiencyTuner> efficiency;
+    std::vector<CpuLaunchData> efficiencyProfile;
+    uint64_t telemetryTs    = 0;
+#   endif
 };
 
 
@@ -268,6 +469,35 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+#   ifdef XMRIG_FEATURE_MSR
+    if (d_ptr->msrExplorer && !d_ptr->threads.empty()) {
+        d_ptr->msrExplorer->tick(hashrate(), Chrono::steadyMSecs());
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    const uint64_t now = Chrono::steadyMSecs();
+    if (now - d_ptr->telemetryTs >= CpuTelemetry::kInterval) {
+        d_ptr->telemetry.sample();
+        d_ptr->telemetryTs = now;
+
+        if (d_ptr->efficiency && !d_ptr->threads.empty() && !d_ptr->isExploring() && d_ptr->efficiency->update(hashrate(), now)) {
+            const auto &cpu = d_ptr->controller->config()->cpu();
+            auto threads    = cpu.get(d_ptr->controller->miner(), d_ptr->algo, d_ptr->efficiency->current().threads, d_ptr->efficiency->current().intensity);
+
+            if (d_ptr->canReconcile(threads)) {
+                d_ptr->reconcile(std::move(threads));
+            }
+            else {
+                stop();
+
+                d_ptr->threads = std::move(threads);
+                d_ptr->start();
+            }
+        }
+    }
+#   endif
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -330,6 +560,23 @@ void xmrig::CpuBackend::printHashrate(bool details)
          i++;
     }
 
+    if (Cpu::info()->isHybrid()) {
+        static const char *coreTypes[] = { "P-cores", "E-cores" };
+        size_t count[2]     = { 0 };
+        double total[2][3]  = { { 0.0 } };
+
+        d_ptr->coreTypeHashrate(count, total);
+
+        for (size_t type = 0; type < 2; ++type) {
+            Log::print("| %8s |        - | %7s | %7s | %7s |",
+                       coreTypes[type],
+                       Hashrate::format(total[type][0], num,         sizeof num / 3),
+                       Hashrate::format(total[type][1], num + 8,     sizeof num / 3),
+                       Hashrate::format(total[type][2], num + 8 * 2, sizeof num / 3)
+                       );
+        }
+    }
+
     Log::print(WHITE_BOLD_S "|        - |        - | %7s | %7s | %7s |",
                Hashrate::format(hashrate()->calc(Hashrate::ShortInterval),  num,         sizeof num / 3),
                Hashrate::format(hashrate()->calc(Hashrate::MediumInterval), num + 8,     sizeof num / 3),
@@ -340,6 +587,9 @@ void xmrig::CpuBackend::printHashrate(bool details)
 
 void xmrig::CpuBackend::printHealth()
 {
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    d_ptr->telemetry.print(hashrate() ? hashrate()->calc(Hashrate::ShortInterval) : 0.0);
+#   endif
 }
 
 
@@ -351,13 +601,28 @@ void xmrig::CpuBackend::setJob(const Job &job)
 
     const auto &cpu = d_ptr->controller->config()->cpu();
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    d_ptr->workers.setWatchdog(BenchState::size() ? 0 : cpu.watchdog(), cpu.isWatchdogRestart());
+#   else
+    d_ptr->workers.setWatchdog(cpu.watchdog(), cpu.isWatchdogRestart());
+#   endif
+
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    threads = d_ptr->efficient(cpu, job.algorithm(), std::move(threads));
+#   endif
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
     }
 
     d_ptr->algo         = job.algorithm();
     d_ptr->profileName  = cpu.threads().profileName(job.algorithm());
+    d_ptr->plan         = CpuPlan();
+
+#   ifdef XMRIG_FEATURE_MSR
+    d_ptr->explore();
+#   endif
 
     if (d_ptr->profileName.isNull() || threads.empty()) {
         LOG_WARN("%s " RED_BOLD("disabled") YELLOW(" (no suitable configuration found)"), Tags::cpu());
@@ -365,6 +630,10 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
+    if (d_ptr->canReconcile(threads)) {
+        return d_ptr->reconcile(std::move(threads));
+    }
+
     stop();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -425,9 +694,16 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("priority",   cpu.priority(), allocator);
     out.AddMember("msr",        Rx::isMSR(), allocator);
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    if (RxResctrl::isEnabled()) {
+        out.AddMember("cache-qos", RxResctrl::toJSON(doc), allocator);
+    }
+#   endif
+
 #   ifdef XMRIG_FEATURE_ASM
     const Assembly assembly = Cpu::assembly(cpu.assembly());
     out.AddMember("asm", assembly.toJSON(), allocator);
+    out.AddMember("cn-r-cache", CnRCache::toJSON(doc), allocator);
 #   else
     out.AddMember("asm", false, allocator);
 #   endif
@@ -438,10 +714,45 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
 #   ifdef XMRIG_ALGO_ASTROBWT
     out.AddMember("astrobwt-max-size", cpu.astrobwtMaxSize(), allocator);
+    out.AddMember("astrobwt-sort", StringRef(astrobwt::sort_name()), allocator);
+#   endif
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (d_ptr->algo.family() == Algorithm::GHOSTRIDER) {
+        out.AddMember("ghostrider-core-hashes", ghostrider::toJSON(doc), allocator);
+    }
 #   endif
 
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
+    out.AddMember("memory-regions", VirtualMemory::toJSON(doc), allocator);
+    out.AddMember("scratchpad-pool", ScratchpadPool::toJSON(doc), allocator);
+
+    if (d_ptr->algo.isValid()) {
+        out.AddMember("plan", d_ptr->currentPlan(cpu.limit()).toJSON(doc), allocator);
+    }
+
+#   ifdef XMRIG_FEATURE_MSR
+    if (d_ptr->msrExplorer) {
+        out.AddMember("msr-explore", d_ptr->msrExplorer->toJSON(doc), allocator);
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    if (d_ptr->efficiency) {
+        out.AddMember("efficiency", d_ptr->efficiency->toJSON(doc), allocator);
+    }
+
+    const CpuTelemetry &telemetry = d_ptr->telemetry;
+    if (telemetry.isReady()) {
+        Value obj = telemetry.toJSON(doc);
+        const double power = telemetry.power();
+        const double h     = hashrate() ? hashrate()->calc(Hashrate::ShortInterval) : 0.0;
+
+        obj.AddMember("hashes-per-joule", power > 0.0 && std::isnormal(h) ? Value(h / power) : Value(kNullType), allocator);
+        out.AddMember("telemetry", obj, allocator);
+    }
+#   endif
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -449,8 +760,16 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("hashrate", hashrate()->toJSON(doc), allocator);
 
+    const HashrateWatchdog *watchdog = d_ptr->workers.watchdog();
+    if (watchdog->isEnabled()) {
+        out.AddMember("watchdog", watchdog->toJSON(doc), allocator);
+    }
+
     Value threads(kArrayType);
 
+    static const char *coreTypes[] = { "performance", "efficiency" };
+    const bool hybrid = Cpu::info()->isHybrid();
+
     size_t i = 0;
     for (const CpuLaunchData &data : d_ptr->threads) {
         Value thread(kObjectType);
@@ -459,12 +778,51 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        if (watchdog->isEnabled()) {
+            thread.AddMember("watchdog", watchdog->toJSON(i, doc), allocator);
+        }
+
+        if (hybrid) {
+            thread.AddMember("core-type", StringRef(coreTypes[Cpu::info()->coreType(data.affinity)]), allocator);
+        }
+
+#       ifdef XMRIG_FEATURE_TELEMETRY
+        const CpuTelemetry::Core *core = telemetry.isReady() ? telemetry.core(data.affinity) : nullptr;
+        if (core) {
+            thread.AddMember("freq", core->freq, allocator);
+            thread.AddMember("c0",   core->c0 >= 0.0 ? Value(core->c0) : Value(kNullType), allocator);
+        }
+#       endif
+
         i++;
         threads.PushBack(thread, allocator);
     }
 
     out.AddMember("threads", threads, allocator);
 
+    if (hybrid) {
+        size_t count[2]     = { 0 };
+        double total[2][3]  = { { 0.0 } };
+        d_ptr->coreTypeHashrate(count, total);
+
+        Value types(kObjectType);
+
+        for (size_t type = 0; type < 2; ++type) {
+            Value obj(kObjectType);
+
+            Value hr(kArrayType);
+            for (double h : total[type]) {
+                hr.PushBack(Hashrate::normalize(h), allocator);
+            }
+
+            obj.AddMember("threads",  static_cast<uint64_t>(count[type]), allocator);
+            obj.AddMember("hashrate", hr, allocator);
+            types.AddMember(StringRef(coreTypes[type]), obj, allocator);
+        }
+
+        out.AddMember("core-types", types, allocator);
+    }
+
     return out;
 }
 
@@ -27,6 +27,8 @@
 
 namespace xmrig {
 
+const char *CpuConfig::kEfficiency          = "efficiency";
+const char *CpuConfig::kEfficiencyPowerLimit = "efficiency-power-limit";
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
 const char *CpuConfig::kHugePages           = "huge-pages";
@@ -35,6 +37,9 @@ const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
 const char *CpuConfig::kPriority            = "priority";
+const char *CpuConfig::kSelfTestPerThread   = "self-test-per-thread";
+const char *CpuConfig::kWatchdog            = "watchdog";
+const char *CpuConfig::kWatchdogRestart     = "watchdog-restart";
 const char *CpuConfig::kYield               = "yield";
 
 #ifdef XMRIG_FEATURE_ASM
@@ -48,6 +53,7 @@ const char *CpuConfig::kArgon2Impl          = "argon2-impl";
 #ifdef XMRIG_ALGO_ASTROBWT
 const char *CpuConfig::kAstroBWTMaxSize     = "astrobwt-max-size";
 const char *CpuConfig::kAstroBWTAVX2        = "astrobwt-avx2";
+const char *CpuConfig::kAstroBWTSort        = "astrobwt-sort";
 #endif
 
 
@@ -76,6 +82,11 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kWatchdog),     m_watchdog == 0 ? Value(false) : Value(m_watchdog), allocator);
+    obj.AddMember(StringRef(kWatchdogRestart), m_watchdogRestart, allocator);
+    obj.AddMember(StringRef(kEfficiency),   m_efficiency, allocator);
+    obj.AddMember(StringRef(kEfficiencyPowerLimit), m_efficiencyPowerLimit, allocator);
+    obj.AddMember(StringRef(kSelfTestPerThread), m_selfTestPerThread, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -92,6 +103,7 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
 #   ifdef XMRIG_ALGO_ASTROBWT
     obj.AddMember(StringRef(kAstroBWTMaxSize),  m_astrobwtMaxSize, allocator);
     obj.AddMember(StringRef(kAstroBWTAVX2),     m_astrobwtAVX2, allocator);
+    obj.AddMember(StringRef(kAstroBWTSort),     m_astrobwtSort.toJSON(), allocator);
 #   endif
 
     m_threads.toJSON(obj, doc);
@@ -106,7 +118,8 @@ size_t xmrig::CpuConfig::memPoolSize() const
 }
 
 
-std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm) const
+// Optional limit keeps only the first threads of the profile and intensity caps every thread, used by the efficiency mode
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, size_t limit, uint32_t intensity) const
 {
     if (algorithm.family() == Algorithm::KAWPOW) {
         return {};
@@ -119,18 +132,20 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
         return out;
     }
 
-    const size_t count = threads.count();
+    const size_t count = limit ? std::min(limit, threads.count()) : threads.count();
     out.reserve(count);
 
     std::vector<int64_t> affinities;
     affinities.reserve(count);
 
-    for (const auto& thread : threads.data()) {
-        affinities.emplace_back(thread.affinity());
+    for (size_t i = 0; i < count; ++i) {
+        affinities.emplace_back(threads.data()[i].affinity());
     }
 
-    for (const auto &thread : threads.data()) {
-        out.emplace_back(miner, algorithm, *this, thread, count, affinities);
+    for (size_t i = 0; i < count; ++i) {
+        const auto &thread = threads.data()[i];
+
+        out.emplace_back(miner, algorithm, *this, intensity ? CpuThread(thread.affinity(), std::min(thread.intensity(), intensity)) : thread, count, affinities);
     }
 
     return out;
@@ -145,9 +160,15 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
 
+        m_watchdogRestart = Json::getBool(value, kWatchdogRestart, m_watchdogRestart);
+        m_efficiency      = Json::getBool(value, kEfficiency, m_efficiency);
+        m_efficiencyPowerLimit = Json::getBool(value, kEfficiencyPowerLimit, m_efficiencyPowerLimit);
+        m_selfTestPerThread    = Json::getBool(value, kSelfTestPerThread, m_selfTestPerThread);
+
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
         setMemoryPool(Json::getValue(value, kMemoryPool));
+        setWatchdog(Json::getValue(value, kWatchdog));
         setPriority(Json::getInt(value,  kPriority, -1));
 
 #       ifdef XMRIG_FEATURE_ASM
@@ -174,6 +195,8 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         else {
             m_astrobwtAVX2 = astroBWTAVX2.GetBool();
         }
+
+        m_astrobwtSort = Json::getString(value, kAstroBWTSort);
 #       endif
 
         m_threads.read(value);
@@ -246,3 +269,14 @@ void xmrig::CpuConfig::setMemoryPool(const rapidjson::Value &value)
         m_memoryPool = value.GetInt();
     }
 }
+
+
+void xmrig::CpuConfig::setWatchdog(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_watchdog = value.GetBool() ? kDefaultWatchdog : 0;
+    }
+    else if (value.IsUint()) {
+        m_watchdog = std::min(value.GetUint(), 95U);
+    }
+}
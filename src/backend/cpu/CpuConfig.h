@@ -38,6 +38,8 @@ public:
         AES_SOFT
     };
 
+    static const char *kEfficiency;
+    static const char *kEfficiencyPowerLimit;
     static const char *kEnabled;
     static const char *kField;
     static const char *kHugePages;
@@ -46,6 +48,9 @@ public:
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
     static const char *kPriority;
+    static const char *kSelfTestPerThread;
+    static const char *kWatchdog;
+    static const char *kWatchdogRestart;
     static const char *kYield;
 
 #   ifdef XMRIG_FEATURE_ASM
@@ -59,6 +64,7 @@ public:
 #   ifdef XMRIG_ALGO_ASTROBWT
     static const char *kAstroBWTMaxSize;
     static const char *kAstroBWTAVX2;
+    static const char *kAstroBWTSort;
 #   endif
 
     CpuConfig() = default;
@@ -66,48 +72,62 @@ public:
     bool isHwAES() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t memPoolSize() const;
-    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, size_t limit = 0, uint32_t intensity = 0) const;
     void read(const rapidjson::Value &value);
 
     inline bool astrobwtAVX2() const                    { return m_astrobwtAVX2; }
+    inline bool isEfficiency() const                    { return m_efficiency; }
+    inline bool isEfficiencyPowerLimit() const          { return m_efficiencyPowerLimit; }
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isSelfTestPerThread() const             { return m_selfTestPerThread; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
+    inline bool isWatchdogRestart() const               { return m_watchdogRestart; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
+    inline const String &astrobwtSort() const           { return m_astrobwtSort; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int astrobwtMaxSize() const                  { return m_astrobwtMaxSize; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
     inline uint32_t limit() const                       { return m_limit; }
+    inline uint32_t watchdog() const                    { return m_watchdog; }
 
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
     constexpr static size_t kOneGbPageSizeKb        = 1048576U;
+    constexpr static uint32_t kDefaultWatchdog      = 70U;
 
     void generate();
     void setAesMode(const rapidjson::Value &value);
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
+    void setWatchdog(const rapidjson::Value &value);
 
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
     bool m_astrobwtAVX2     = false;
+    bool m_efficiency       = false;
+    bool m_efficiencyPowerLimit = false;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
+    bool m_selfTestPerThread = false;
     bool m_shouldSave       = false;
+    bool m_watchdogRestart  = false;
     bool m_yield            = true;
     int m_astrobwtMaxSize   = 550;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
     String m_argon2Impl;
+    String m_astrobwtSort;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
+    uint32_t m_watchdog     = kDefaultWatchdog;
 };
 
 
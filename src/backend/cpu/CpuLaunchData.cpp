@@ -38,18 +38,33 @@ xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorit
     astrobwtAVX2(config.astrobwtAVX2()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    selfTestPerThread(config.isSelfTestPerThread()),
     yield(config.isYield()),
     astrobwtMaxSize(config.astrobwtMaxSize()),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
     threads(threads),
-    intensity(std::max<uint32_t>(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()), algorithm.minIntensity())),
+    astrobwtSort(config.astrobwtSort()),
+    intensity(clampIntensity(algorithm, thread.intensity())),
     affinities(affinities)
 {
 }
 
 
+uint32_t xmrig::CpuLaunchData::clampIntensity(const Algorithm &algorithm, uint32_t intensity)
+{
+    intensity = std::max<uint32_t>(std::min<uint32_t>(intensity, algorithm.maxIntensity()), algorithm.minIntensity());
+
+    // CryptoNight has 1-5 way and 8 way implementations only.
+    if (algorithm.isCN() && intensity > 5 && intensity < 8) {
+        return 5;
+    }
+
+    return intensity;
+}
+
+
 bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
 {
     return (algorithm.l3()      == other.algorithm.l3()
@@ -59,12 +74,18 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && intensity        == other.intensity
             && priority         == other.priority
             && affinity         == other.affinity
+            && (algorithm.family() != Algorithm::ASTROBWT || (astrobwtAVX2 == other.astrobwtAVX2 && astrobwtMaxSize == other.astrobwtMaxSize && astrobwtSort == other.astrobwtSort))
+            && (algorithm.family() != Algorithm::GHOSTRIDER || affinities == other.affinities)
             );
 }
 
 
 xmrig::CnHash::AlgoVariant xmrig::CpuLaunchData::av() const
 {
+    if (intensity == 8) {
+        return !hwAES ? CnHash::AV_OCTA_SOFT : CnHash::AV_OCTA;
+    }
+
     if (intensity <= 2) {
         return static_cast<CnHash::AlgoVariant>(!hwAES ? (intensity + 2) : intensity);
     }
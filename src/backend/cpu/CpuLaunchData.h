@@ -28,6 +28,7 @@
 
 
 #include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
 #include "crypto/cn/CnHash.h"
 #include "crypto/common/Assembly.h"
 #include "crypto/common/Nonce.h"
@@ -55,18 +56,21 @@ public:
     inline bool operator==(const CpuLaunchData &other) const    { return isEqual(other); }
 
     static const char *tag();
+    static uint32_t clampIntensity(const Algorithm &algorithm, uint32_t intensity);
 
     const Algorithm algorithm;
     const Assembly assembly;
     const bool astrobwtAVX2;
     const bool hugePages;
     const bool hwAES;
+    const bool selfTestPerThread;
     const bool yield;
     const int astrobwtMaxSize;
     const int priority;
     const int64_t affinity;
     const Miner *miner;
     const size_t threads;
+    const String astrobwtSort;
     const uint32_t intensity;
     const std::vector<int64_t> affinities;
 };
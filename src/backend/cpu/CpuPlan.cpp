@@ -0,0 +1,277 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuPlan.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/CpuThreads.h"
+#include "backend/cpu/interfaces/ICpuInfo.h"
+
+
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+
+
+namespace xmrig {
+
+
+static inline const char *domainName(int32_t level)
+{
+    switch (level) {
+    case 2:
+        return "L2";
+
+    case 3:
+        return "L3";
+
+    default:
+        break;
+    }
+
+    return "host";
+}
+
+
+} // namespace xmrig
+
+
+void xmrig::CpuPlan::Domain::note(const char *fmt, ...)
+{
+    char buf[256]{};
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    notes.emplace_back(static_cast<const char *>(buf));
+}
+
+
+xmrig::CpuPlan::CpuPlan(const char *backend, const Algorithm &algorithm, uint32_t limit) :
+    m_algorithm(algorithm),
+    m_backend(backend),
+    m_limit(limit)
+{
+}
+
+
+xmrig::CpuPlan::CpuPlan(const ICpuInfo *info, const Algorithm &algorithm, uint32_t limit) :
+    CpuPlan(info->backend(), algorithm, limit)
+{
+    const CpuThreads threads = info->threads(algorithm, limit);
+
+    auto &domain = addDomain();
+    domain.cache = info->L3() ? info->L3() : info->L2();
+    domain.level = info->L3() ? 3 : (info->L2() ? 2 : 0);
+    domain.cores = info->cores();
+    domain.PUs   = info->threads();
+
+    if (!threads.isEmpty()) {
+        domain.intensity = threads.data().front().intensity();
+    }
+
+    for (const auto &thread : threads.data()) {
+        domain.affinity.emplace_back(thread.affinity());
+    }
+
+    domain.note("no cache topology available, threads are chosen per algorithm family");
+
+    evaluate(threads);
+}
+
+
+rapidjson::Value xmrig::CpuPlan::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("algo",       StringRef(m_algorithm.name()), allocator);
+    out.AddMember("backend",    m_backend ? Value(StringRef(m_backend)) : Value(kNullType), allocator);
+    out.AddMember("scratchpad", static_cast<uint64_t>(m_algorithm.l3()), allocator);
+    out.AddMember("limit",      m_limit, allocator);
+
+    Value domains(kArrayType);
+    for (const auto &domain : m_domains) {
+        Value obj(kObjectType);
+        obj.AddMember("type",       StringRef(domainName(domain.level)), allocator);
+        obj.AddMember("size",       static_cast<uint64_t>(domain.cache), allocator);
+        obj.AddMember("exclusive",  domain.exclusive, allocator);
+        obj.AddMember("l2",         static_cast<uint64_t>(domain.L2), allocator);
+        obj.AddMember("extra",      static_cast<uint64_t>(domain.extra), allocator);
+        obj.AddMember("cores",      static_cast<uint64_t>(domain.cores), allocator);
+        obj.AddMember("e-cores",    static_cast<uint64_t>(domain.eCores), allocator);
+        obj.AddMember("threads",    static_cast<uint64_t>(domain.PUs), allocator);
+        obj.AddMember("fits",       static_cast<uint64_t>(domain.hashes), allocator);
+        obj.AddMember("intensity",  domain.intensity, allocator);
+
+        Value affinity(kArrayType);
+        for (const int64_t cpu : domain.affinity) {
+            affinity.PushBack(cpu, allocator);
+        }
+
+        Value notes(kArrayType);
+        for (const auto &note : domain.notes) {
+            notes.PushBack(Value(note.data(), allocator), allocator);
+        }
+
+        obj.AddMember("affinity",   affinity, allocator);
+        obj.AddMember("notes",      notes, allocator);
+
+        domains.PushBack(obj, allocator);
+    }
+
+    Value candidates(kArrayType);
+    for (const auto &candidate : m_candidates) {
+        Value obj(kObjectType);
+        obj.AddMember("name",       StringRef(candidate.name), allocator);
+        obj.AddMember("threads",    static_cast<uint64_t>(candidate.threads), allocator);
+        obj.AddMember("ways",       static_cast<uint64_t>(candidate.ways), allocator);
+        obj.AddMember("memory",     static_cast<uint64_t>(candidate.ways * m_algorithm.l3()), allocator);
+        obj.AddMember("pressure",   candidate.pressure, allocator);
+        obj.AddMember("selected",   candidate.selected, allocator);
+        obj.AddMember("reason",     Value(candidate.reason.data(), allocator), allocator);
+
+        candidates.PushBack(obj, allocator);
+    }
+
+    out.AddMember("domains",    domains, allocator);
+    out.AddMember("candidates", candidates, allocator);
+
+    return out;
+}
+
+
+void xmrig::CpuPlan::evaluate(const CpuThreads &threads)
+{
+    size_t cores  = 0;
+    size_t eCores = 0;
+    size_t PUs    = 0;
+
+    m_capacity = 0;
+    m_hashes   = 0;
+
+    for (const auto &domain : m_domains) {
+        m_capacity += domain.cache + domain.extra;
+        m_hashes   += domain.hashes;
+        cores      += domain.cores;
+        eCores     += domain.eCores;
+        PUs        += domain.PUs;
+    }
+
+    size_t ways = 0;
+    for (const auto &thread : threads.data()) {
+        ways += thread.intensity();
+    }
+
+    m_candidates.clear();
+    addCandidate("cache-aware", threads.count(), ways);
+
+    if (PUs) {
+        addCandidate("all-threads", PUs, PUs);
+    }
+
+    if (cores && cores != PUs) {
+        addCandidate("physical-cores", cores, cores);
+    }
+
+    if (eCores && eCores < cores) {
+        addCandidate("performance-cores", cores - eCores, cores - eCores);
+    }
+}
+
+
+void xmrig::CpuPlan::print() const
+{
+    printf("%s: scratchpad %zu KB, max threads hint %u%%, %s\n", m_algorithm.name(), m_algorithm.l3() / 1024, m_limit, m_backend ? m_backend : "n/a");
+
+    for (const auto &domain : m_domains) {
+        printf("  %s %zu KB%s", domainName(domain.level), domain.cache / 1024, domain.exclusive ? " exclusive" : "");
+
+        if (domain.L2) {
+            printf(", L2 %zu KB", domain.L2 / 1024);
+        }
+
+        printf(", %zu cores", domain.cores);
+
+        if (domain.eCores) {
+            printf(" (%zu E)", domain.eCores);
+        }
+
+        printf(", %zu threads, fits %zu -> %zu x%u [", domain.PUs, domain.hashes, domain.affinity.size(), domain.intensity);
+
+        for (size_t i = 0; i < domain.affinity.size(); ++i) {
+            printf(i ? ",%" PRId64 : "%" PRId64, domain.affinity[i]);
+        }
+
+        printf("]\n");
+
+        for (const auto &note : domain.notes) {
+            printf("    - %s\n", note.data());
+        }
+    }
+
+    for (const auto &candidate : m_candidates) {
+        printf("  %c %-18s %3zu threads %3zu ways %7zu KB pressure %4.2f  %s\n",
+               candidate.selected ? '*' : ' ',
+               candidate.name,
+               candidate.threads,
+               candidate.ways,
+               candidate.ways * m_algorithm.l3() / 1024,
+               candidate.pressure,
+               candidate.reason.data()
+               );
+    }
+}
+
+
+void xmrig::CpuPlan::addCandidate(const char *name, size_t threads, size_t ways)
+{
+    Candidate candidate;
+    candidate.name     = name;
+    candidate.threads  = threads;
+    candidate.ways     = ways;
+    candidate.pressure = m_capacity ? static_cast<double>(ways * m_algorithm.l3()) / m_capacity : 0.0;
+    candidate.selected = m_candidates.empty();
+
+    char buf[128]{};
+
+    if (candidate.selected) {
+        snprintf(buf, sizeof(buf), "selected by the cache model");
+    }
+    else if (threads == m_candidates.front().threads && ways == m_candidates.front().ways) {
+        snprintf(buf, sizeof(buf), "same size as selected");
+    }
+    else if (m_capacity && ways > m_hashes) {
+        snprintf(buf, sizeof(buf), "needs %zu scratchpads, cache fits %zu", ways, m_hashes);
+    }
+    else if (m_limit < 100 && threads > m_candidates.front().threads) {
+        snprintf(buf, sizeof(buf), "exceeds max threads hint %u%%", m_limit);
+    }
+    else if (ways < m_candidates.front().ways) {
+        snprintf(buf, sizeof(buf), "%zu lanes less than selected", m_candidates.front().ways - ways);
+    }
+    else {
+        snprintf(buf, sizeof(buf), "rejected by per domain rules");
+    }
+
+    candidate.reason = static_cast<const char *>(buf);
+
+    m_candidates.push_back(std::move(candidate));
+}
@@ -0,0 +1,106 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUPLAN_H
+#define XMRIG_CPUPLAN_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+class CpuThreads;
+class ICpuInfo;
+
+
+/**
+ * Explains the automatic thread configuration for one algorithm.
+ *
+ * Every top level cache (L3, or L2 without L3) is a domain: its capacity, cores, SMT threads, efficiency cores
+ * and how many scratchpads of the algorithm fit into it, together with the rules that decided the threads placed
+ * there. Alternative layouts of the whole host are scored by scratchpad pressure (memory of all lanes / cache).
+ */
+class CpuPlan
+{
+public:
+    struct Domain
+    {
+        void note(const char *fmt, ...);
+
+        int32_t level           = 0;
+        size_t cache            = 0;
+        size_t extra            = 0;
+        size_t L2               = 0;
+        bool exclusive          = false;
+        size_t cores            = 0;
+        size_t eCores           = 0;
+        size_t PUs              = 0;
+        size_t hashes           = 0;
+        uint32_t intensity      = 1;
+        std::vector<int64_t> affinity;
+        std::vector<String> notes;
+    };
+
+    struct Candidate
+    {
+        const char *name        = nullptr;
+        size_t threads          = 0;
+        size_t ways             = 0;
+        double pressure         = 0.0;
+        bool selected           = false;
+        String reason;
+    };
+
+    CpuPlan() = default;
+    CpuPlan(const char *backend, const Algorithm &algorithm, uint32_t limit);
+    CpuPlan(const ICpuInfo *info, const Algorithm &algorithm, uint32_t limit);
+
+    inline bool isValid() const                                 { return m_algorithm.isValid(); }
+    inline const Algorithm &algorithm() const                   { return m_algorithm; }
+    inline const std::vector<Candidate> &candidates() const     { return m_candidates; }
+    inline const std::vector<Domain> &domains() const           { return m_domains; }
+    inline Domain &addDomain()                                  { m_domains.emplace_back(); return m_domains.back(); }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void evaluate(const CpuThreads &threads);
+    void print() const;
+
+private:
+    void addCandidate(const char *name, size_t threads, size_t ways);
+
+    Algorithm m_algorithm;
+    const char *m_backend       = nullptr;
+    size_t m_capacity           = 0;
+    size_t m_hashes             = 0;
+    std::vector<Candidate> m_candidates;
+    std::vector<Domain> m_domains;
+    uint32_t m_limit            = 100;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUPLAN_H */
@@ -17,6 +17,8 @@
  */
 
 #include <cassert>
+#include <condition_variable>
+#include <map>
 #include <thread>
 #include <mutex>
 
@@ -30,6 +32,7 @@
 #include "crypto/cn/CryptoNight_test.h"
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/Nonce.h"
+#include "crypto/common/ScratchpadPool.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -44,6 +47,8 @@
 
 
 #ifdef XMRIG_ALGO_ASTROBWT
+#   include "base/io/log/Log.h"
+#   include "base/io/log/Tags.h"
 #   include "crypto/astrobwt/AstroBWT.h"
 #endif
 
@@ -53,6 +58,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "crypto/rx/RxResctrl.h"
+#endif
+
+
 namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
@@ -61,8 +71,49 @@ static constexpr uint32_t kReserveCount = 32768;
 #ifdef XMRIG_ALGO_CN_HEAVY
 static std::mutex cn_heavyZen3MemoryMutex;
 VirtualMemory* cn_heavyZen3Memory = nullptr;
+
+// Workers of each Zen3 cn-heavy block, a block outgrown by a larger thread set is freed by the last of its workers
+static std::map<const VirtualMemory *, size_t> cn_heavyZen3Users;
+
+
+static bool isZen3Memory(const VirtualMemory *memory)
+{
+    std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
+
+    return cn_heavyZen3Users.count(memory) > 0;
+}
+
+
+static bool releaseZen3Memory(VirtualMemory *memory)
+{
+    std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
+
+    auto it = cn_heavyZen3Users.find(memory);
+    if (it == cn_heavyZen3Users.end()) {
+        return false;
+    }
+
+    if (--it->second == 0 && memory != cn_heavyZen3Memory) {
+        cn_heavyZen3Users.erase(it);
+        delete memory;
+    }
+
+    return true;
+}
 #endif
 
+
+// Self-test results shared by all threads using the same hash implementation, see CpuWorker::selfTest().
+enum SelfTestState : int {
+    SELF_TEST_RUNNING,
+    SELF_TEST_PASSED,
+    SELF_TEST_FAILED
+};
+
+static std::condition_variable selfTestCv;
+static std::map<uint64_t, SelfTestState> selfTestResults;
+static std::mutex selfTestMutex;
+
 } // namespace xmrig
 
 
@@ -74,11 +125,13 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_assembly(data.assembly),
     m_astrobwtAVX2(data.astrobwtAVX2),
     m_hwAES(data.hwAES),
+    m_selfTestPerThread(data.selfTestPerThread),
     m_yield(data.yield),
     m_av(data.av()),
     m_astrobwtMaxSize(data.astrobwtMaxSize * 1000),
     m_miner(data.miner),
     m_threads(data.threads),
+    m_astrobwtSort(data.astrobwtSort),
     m_ctx()
 {
 #   ifdef XMRIG_ALGO_CN_HEAVY
@@ -86,17 +139,26 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     const bool is_vermeer = (Cpu::info()->arch() == ICpuInfo::ARCH_ZEN3) && (Cpu::info()->model() == 0x21);
     if ((N == 1) && (m_av == CnHash::AV_SINGLE) && (m_algorithm.family() == Algorithm::CN_HEAVY) && (m_assembly != Assembly::NONE) && is_vermeer) {
         std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
-        if (!cn_heavyZen3Memory) {
-            // Round up number of threads to the multiple of 8
-            const size_t num_threads = ((m_threads + 7) / 8) * 8;
+
+        // Round up number of threads to the multiple of 8
+        const size_t num_threads = ((m_threads + 7) / 8) * 8;
+        if (!cn_heavyZen3Memory || cn_heavyZen3Memory->size() < m_algorithm.l3() * num_threads) {
+            // Workers kept from a smaller thread set stay on the previous block
+            if (cn_heavyZen3Memory && cn_heavyZen3Users[cn_heavyZen3Memory] == 0) {
+                cn_heavyZen3Users.erase(cn_heavyZen3Memory);
+                delete cn_heavyZen3Memory;
+            }
+
             cn_heavyZen3Memory = new VirtualMemory(m_algorithm.l3() * num_threads, data.hugePages, false, false, node());
+            cn_heavyZen3Memory->setTag("scratchpad");
         }
         m_memory = cn_heavyZen3Memory;
+        ++cn_heavyZen3Users[m_memory];
     }
     else
 #   endif
     {
-        m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node());
+        m_memory = ScratchpadPool::acquire(m_algorithm.l3() * N, data.hugePages, node());
     }
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -115,10 +177,10 @@ xmrig::CpuWorker<N>::~CpuWorker()
     CnCtx::release(m_ctx, N);
 
 #   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_memory != cn_heavyZen3Memory)
+    if (!releaseZen3Memory(m_memory))
 #   endif
     {
-        delete m_memory;
+        ScratchpadPool::release(m_memory);
     }
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -163,6 +225,62 @@ bool xmrig::CpuWorker<N>::selfTest()
 
     allocateCnCtx();
 
+#   ifdef XMRIG_ALGO_ASTROBWT
+    // Sort selection runs a short benchmark, the first worker does it before hashing and the others wait for it
+    if (m_algorithm.family() == Algorithm::ASTROBWT && astrobwt::select_sort(m_astrobwtSort, m_astrobwtMaxSize, m_astrobwtAVX2)) {
+        if (astrobwt::sort_time(astrobwt::SORT_RADIX) > 0.0) {
+            LOG_INFO("%s use " WHITE_BOLD("astrobwt") " sort " GREEN_BOLD("%s") BLACK_BOLD(" (radix %.1f ms, sais %.1f ms per hash)"),
+                     Tags::cpu(),
+                     astrobwt::sort_name(),
+                     astrobwt::sort_time(astrobwt::SORT_RADIX),
+                     astrobwt::sort_time(astrobwt::SORT_SAIS)
+                     );
+        }
+        else {
+            LOG_INFO("%s use " WHITE_BOLD("astrobwt") " sort " GREEN_BOLD("%s"), Tags::cpu(), astrobwt::sort_name());
+        }
+    }
+#   endif
+
+    if (m_selfTestPerThread) {
+        return runSelfTest();
+    }
+
+    // Results depend only on the hash implementation, the first thread of every (family, variant, assembly, AES) tuple
+    // runs the test and the other threads with the same tuple wait for its result, different tuples run in parallel.
+    const uint64_t key = (static_cast<uint64_t>(m_algorithm.family()) << 32) |
+                         (static_cast<uint64_t>(m_av) << 16) |
+                         (static_cast<uint64_t>(m_assembly.id()) << 8) |
+                         (static_cast<uint64_t>(m_hwAES) << 1) |
+                         static_cast<uint64_t>(m_astrobwtAVX2);
+
+    std::unique_lock<std::mutex> lock(selfTestMutex);
+
+    auto it = selfTestResults.find(key);
+    if (it == selfTestResults.end()) {
+        selfTestResults[key] = SELF_TEST_RUNNING;
+        lock.unlock();
+
+        const bool rc = runSelfTest();
+
+        lock.lock();
+        selfTestResults[key] = rc ? SELF_TEST_PASSED : SELF_TEST_FAILED;
+        lock.unlock();
+
+        selfTestCv.notify_all();
+
+        return rc;
+    }
+
+    selfTestCv.wait(lock, [key] { return selfTestResults[key] != SELF_TEST_RUNNING; });
+
+    return selfTestResults[key] == SELF_TEST_PASSED;
+}
+
+
+template<size_t N>
+bool xmrig::CpuWorker<N>::runSelfTest()
+{
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (m_algorithm.family() == Algorithm::GHOSTRIDER) {
         return (N == 8) && verify(Algorithm::GHOSTRIDER_RTM, test_output_gr);
@@ -243,14 +361,18 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
-    while (Nonce::sequence(Nonce::CPU) > 0) {
+#   ifdef XMRIG_FEATURE_RESCTRL
+    RxResctrl::join();
+#   endif
+
+    while (Nonce::sequence(Nonce::CPU) > 0 && !isStopped()) {
         if (Nonce::isPaused()) {
             do {
                 std::this_thread::sleep_for(std::chrono::milliseconds(20));
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
+            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0 && !isStopped());
 
-            if (Nonce::sequence(Nonce::CPU) == 0) {
+            if (Nonce::sequence(Nonce::CPU) == 0 || isStopped()) {
                 break;
             }
 
@@ -262,7 +384,7 @@ void xmrig::CpuWorker<N>::start()
         alignas(16) uint64_t tempHash[8] = {};
 #       endif
 
-        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence()) && !isStopped()) {
             const Job &job = m_job.currentJob();
 
             if (job.algorithm().l3() != m_algorithm.l3()) {
@@ -277,6 +399,10 @@ void xmrig::CpuWorker<N>::start()
 #           ifdef XMRIG_FEATURE_BENCHMARK
             if (m_benchSize) {
                 if (current_job_nonces[0] >= m_benchSize) {
+#                   ifdef XMRIG_FEATURE_RESCTRL
+                    RxResctrl::leave();
+#                   endif
+
                     return BenchState::done();
                 }
 
@@ -372,6 +498,10 @@ void xmrig::CpuWorker<N>::start()
 
         consumeJob();
     }
+
+#   ifdef XMRIG_FEATURE_RESCTRL
+    RxResctrl::leave();
+#   endif
 }
 
 
@@ -433,8 +563,29 @@ bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *refe
         return false;
     }
 
-    func(test_input, 76, m_hash, m_ctx, 0);
-    return memcmp(m_hash, referenceValue, sizeof m_hash) == 0;
+    // Test vectors cover 5 inputs only, wider modes reuse them in a round-robin fashion
+    constexpr size_t inputSize  = 76;
+    constexpr size_t testInputs = sizeof(test_input) / inputSize;
+
+    if (N <= testInputs) {
+        func(test_input, inputSize, m_hash, m_ctx, 0);
+        return memcmp(m_hash, referenceValue, sizeof m_hash) == 0;
+    }
+
+    uint8_t blob[N * inputSize];
+    for (size_t i = 0; i < N; ++i) {
+        memcpy(blob + i * inputSize, test_input + (i % testInputs) * inputSize, inputSize);
+    }
+
+    func(blob, inputSize, m_hash, m_ctx, 0);
+
+    for (size_t i = 0; i < N; ++i) {
+        if (memcmp(m_hash + i * 32, referenceValue + (i % testInputs) * 32, 32) != 0) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 
@@ -497,7 +648,7 @@ void xmrig::CpuWorker<N>::allocateCnCtx()
 
 #       ifdef XMRIG_ALGO_CN_HEAVY
         // cn-heavy optimization for Zen3 CPUs
-        if (m_memory == cn_heavyZen3Memory) {
+        if (isZen3Memory(m_memory)) {
             shift = (id() / 8) * m_algorithm.l3() * 8 + (id() % 8) * 64;
         }
 #       endif
@@ -78,6 +78,7 @@ private:
 #   endif
 
     bool nextRound();
+    bool runSelfTest();
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
@@ -88,11 +89,13 @@ private:
     const Assembly m_assembly;
     const bool m_astrobwtAVX2;
     const bool m_hwAES;
+    const bool m_selfTestPerThread;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
     const int m_astrobwtMaxSize;
     const Miner *m_miner;
     const size_t m_threads;
+    const String m_astrobwtSort;
     cryptonight_ctx *m_ctx[N];
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
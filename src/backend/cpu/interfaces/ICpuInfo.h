@@ -20,6 +20,7 @@
 #define XMRIG_CPUINFO_H
 
 
+#include "backend/cpu/CpuPlan.h"
 #include "backend/cpu/CpuThreads.h"
 #include "base/crypto/Algorithm.h"
 #include "base/tools/Object.h"
@@ -59,6 +60,11 @@ public:
 
 #   define MSR_NAMES_LIST "none", "ryzen_17h", "ryzen_19h", "intel", "custom"
 
+    enum CoreType : uint32_t {
+        CORE_PERFORMANCE,
+        CORE_EFFICIENCY
+    };
+
     enum Flag : uint32_t {
         FLAG_AES,
         FLAG_VAES,
@@ -98,11 +104,14 @@ public:
     virtual bool hasCatL3() const                                                   = 0;
     virtual bool hasOneGbPages() const                                              = 0;
     virtual bool hasXOP() const                                                     = 0;
+    virtual bool isHybrid() const                                                   = 0;
     virtual bool isVM() const                                                       = 0;
     virtual bool jccErratum() const                                                 = 0;
     virtual const char *backend() const                                             = 0;
     virtual const char *brand() const                                               = 0;
     virtual const std::vector<int32_t> &units() const                               = 0;
+    virtual CpuPlan plan(const Algorithm &algorithm, uint32_t limit) const          = 0;
+    virtual CoreType coreType(int64_t affinity) const                               = 0;
     virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const    = 0;
     virtual MsrMod msrMod() const                                                   = 0;
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                 = 0;
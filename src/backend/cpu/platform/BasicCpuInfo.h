@@ -51,8 +51,11 @@ protected:
     inline bool hasCatL3() const override                       { return has(FLAG_CAT_L3); }
     inline bool hasOneGbPages() const override                  { return has(FLAG_PDPE1GB); }
     inline bool hasXOP() const override                         { return has(FLAG_XOP); }
+    inline bool isHybrid() const override                       { return false; }
     inline bool isVM() const override                           { return has(FLAG_VM); }
+    inline CpuPlan plan(const Algorithm &algorithm, uint32_t limit) const override  { return { this, algorithm, limit }; }
     inline bool jccErratum() const override                     { return m_jccErratum; }
+    inline CoreType coreType(int64_t) const override            { return CORE_PERFORMANCE; }
     inline const char *brand() const override                   { return m_brand; }
     inline const std::vector<int32_t> &units() const override   { return m_units; }
     inline MsrMod msrMod() const override                       { return m_msrMod; }
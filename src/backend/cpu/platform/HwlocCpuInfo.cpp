@@ -92,6 +92,26 @@ static inline size_t countByType(hwloc_topology_t topology, hwloc_obj_type_t typ
 }
 
 
+static inline size_t countInside(hwloc_topology_t topology, hwloc_obj_t obj, hwloc_obj_type_t type)
+{
+    const int count = hwloc_get_nbobjs_inside_cpuset_by_type(topology, obj->cpuset, type);
+
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+
+static inline hwloc_obj_t findParentCache(hwloc_obj_t obj, unsigned depth)
+{
+    for (hwloc_obj_t parent = obj->parent; parent != nullptr; parent = parent->parent) {
+        if (isCacheObject(parent) && parent->attr->cache.depth == depth) {
+            return parent;
+        }
+    }
+
+    return nullptr;
+}
+
+
 #ifndef XMRIG_ARM
 static inline std::vector<hwloc_obj_t> findByType(hwloc_obj_t obj, hwloc_obj_type_t type)
 {
@@ -173,6 +193,16 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
     m_packages  = countByType(m_topology, HWLOC_OBJ_PACKAGE);
 
+#   if HWLOC_API_VERSION >= 0x00020400
+    // Kinds are sorted by efficiency, the last one is the fastest (P-cores on hybrid CPUs)
+    const int kinds = hwloc_cpukinds_get_nr(m_topology, 0);
+    if (kinds > 1) {
+        hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(kinds - 1), nullptr, &m_maxEfficiency, nullptr, nullptr, 0);
+    }
+#   endif
+
+    setEfficiencyUnits();
+
     if (m_nodes > 1) {
         if (hwloc_topology_get_support(m_topology)->membind->set_thisthread_membind) {
             m_features |= SET_THISTHREAD_MEMBIND;
@@ -214,7 +244,77 @@ bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 }
 
 
+xmrig::ICpuInfo::CoreType xmrig::HwlocCpuInfo::coreType(int64_t affinity) const
+{
+    if (affinity < 0 || !std::binary_search(m_efficiencyUnits.begin(), m_efficiencyUnits.end(), static_cast<int32_t>(affinity))) {
+        return CORE_PERFORMANCE;
+    }
+
+    return CORE_EFFICIENCY;
+}
+
+
+xmrig::CpuPlan xmrig::HwlocCpuInfo::plan(const Algorithm &algorithm, uint32_t limit) const
+{
+#   ifndef XMRIG_ARM
+    if (L2() == 0 && L3() == 0) {
+        return BasicCpuInfo::plan(algorithm, limit);
+    }
+
+    CpuPlan plan(backend(), algorithm, limit);
+    plan.evaluate(threads(algorithm, limit, &plan));
+
+    return plan;
+#   else
+    return BasicCpuInfo::plan(algorithm, limit);
+#   endif
+}
+
+
 xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
+{
+    return threads(algorithm, limit, nullptr);
+}
+
+
+bool xmrig::HwlocCpuInfo::isEfficiencyCore(hwloc_obj_t core, bool hybridCache) const
+{
+#   if HWLOC_API_VERSION >= 0x00020400
+    if (m_maxEfficiency > 0) {
+        const int kind = hwloc_cpukinds_get_by_cpuset(m_topology, core->cpuset, 0);
+        int efficiency = -1;
+
+        if (kind >= 0 && hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(kind), nullptr, &efficiency, nullptr, nullptr, 0) == 0) {
+            return efficiency >= 0 && efficiency < m_maxEfficiency;
+        }
+    }
+#   endif
+
+    // No kinds information: single threaded cores next to SMT cores in the same cache (Alder Lake)
+    return hybridCache && hwloc_bitmap_weight(core->cpuset) == 1;
+}
+
+
+uint32_t xmrig::HwlocCpuInfo::efficiencyIntensity(hwloc_obj_t core, size_t scratchpad, uint32_t intensity) const
+{
+    // E-cores share one L2 per cluster, multi-way modes only pay off while every scratchpad still fits in the core's share
+    hwloc_obj_t l2 = findParentCache(core, 2);
+    if (intensity <= 1 || scratchpad == 0 || l2 == nullptr) {
+        return intensity;
+    }
+
+    const size_t share = l2->attr->cache.size / std::max<size_t>(countInside(m_topology, l2, HWLOC_OBJ_CORE), 1);
+    const size_t ways  = share / scratchpad;
+
+    if (ways >= intensity) {
+        return intensity;
+    }
+
+    return static_cast<uint32_t>(std::min<size_t>(std::max<size_t>(ways, 1), 5));
+}
+
+
+xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit, CpuPlan *plan) const
 {
 #   ifndef XMRIG_ARM
     if (L2() == 0 && L3() == 0) {
@@ -237,7 +337,7 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
         int remaining                = std::max(static_cast<int>(maxTotalThreads), 1);
 
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining));
+            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining), plan ? &plan->addDomain() : nullptr);
 
             remaining -= maxPerCache;
             if (remaining <= 0) {
@@ -247,13 +347,17 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
     }
     else {
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, 0);
+            processTopLevelCache(cache, algorithm, threads, 0, plan ? &plan->addDomain() : nullptr);
         }
     }
 
     if (threads.isEmpty()) {
         LOG_WARN("hwloc auto configuration for algorithm \"%s\" failed.", algorithm.name());
 
+        if (plan) {
+            plan->addDomain().note("hwloc auto configuration failed, threads are chosen per algorithm family");
+        }
+
         return BasicCpuInfo::threads(algorithm, limit);
     }
 
@@ -284,7 +388,7 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
 
 
 
-void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const
+void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit, CpuPlan::Domain *domain) const
 {
 #   ifndef XMRIG_ARM
     constexpr size_t oneMiB = 1024U * 1024U;
@@ -298,15 +402,39 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     cores.reserve(m_cores);
     findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) { cores.emplace_back(found); });
 
+    const size_t first       = threads.count();
+    const bool hybridCache   = (PUs > cores.size()) && (PUs < cores.size() * 2);
+    const auto isEfficiency  = [this, hybridCache](hwloc_obj_t c) { return isEfficiencyCore(c, hybridCache); };
+    const size_t eCores      = static_cast<size_t>(std::count_if(cores.begin(), cores.end(), isEfficiency));
+    const bool hybrid        = eCores > 0 && eCores < cores.size();
+
+    if (domain) {
+        domain->level     = static_cast<int32_t>(cache->attr->cache.depth);
+        domain->cache     = cache->attr->cache.size;
+        domain->exclusive = isCacheExclusive(cache);
+        domain->cores     = cores.size();
+        domain->eCores    = eCores;
+        domain->PUs       = PUs;
+    }
+
+    // P-cores take the cache budget first, E-cores come next and SMT siblings of P-cores last
+    if (hybrid) {
+        std::stable_partition(cores.begin(), cores.end(), [&isEfficiency](hwloc_obj_t c) { return !isEfficiency(c); });
+    }
+
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    if ((algorithm == Algorithm::GHOSTRIDER_RTM) && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
+    if ((algorithm == Algorithm::GHOSTRIDER_RTM) && hybrid) {
         // Don't use E-cores on Alder Lake
-        cores.erase(std::remove_if(cores.begin(), cores.end(), [](hwloc_obj_t c) { return hwloc_bitmap_weight(c->cpuset) == 1; }), cores.end());
+        cores.erase(std::remove_if(cores.begin(), cores.end(), isEfficiency), cores.end());
 
         // This shouldn't happen, but check it anyway
         if (cores.empty()) {
             findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) { cores.emplace_back(found); });
         }
+
+        if (domain && cores.size() < domain->cores) {
+            domain->note("%zu single threaded E-cores excluded for GhostRider", domain->cores - cores.size());
+        }
     }
 #   endif
 
@@ -322,6 +450,10 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     if (algorithm == Algorithm::ASTROBWT_DERO) {
         // Use fake low value to force usage of all available cores for AstroBWT (taking 'limit' into account)
         scratchpad = 16 * 1024;
+
+        if (domain) {
+            domain->note("AstroBWT is not cache bound, all threads are used");
+        }
     }
 #   endif
 
@@ -341,28 +473,66 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
         }
     }
 
+    if (domain && extra) {
+        domain->note("exclusive L3, L2 caches add %zu KB", extra / 1024);
+    }
+
     if (scratchpad == 2 * oneMiB) {
         if (L2 && (cores.size() * oneMiB) == L2 && L2_associativity == 16 && L3 >= L2) {
             L3    = L2;
             extra = L2;
+
+            if (domain) {
+                domain->note("1 MB 16-way L2 per core, 2 MB scratchpads are sized by L2");
+            }
         }
     }
 
     size_t cacheHashes = ((L3 + extra) + (scratchpad / 2)) / scratchpad;
 
+    if (domain) {
+        domain->L2     = L2;
+        domain->extra  = extra;
+        domain->hashes = cacheHashes;
+    }
+
     const auto family = algorithm.family();
     if (intensity && ((family == Algorithm::CN_PICO) || (family == Algorithm::CN_FEMTO)) && (cacheHashes / PUs) >= 2) {
         intensity = 2;
+
+        if (domain) {
+            domain->note("cache fits 2 scratchpads per thread, intensity 2");
+        }
     }
 
+#   ifdef XMRIG_VAES512
+    // 8 way mode uses VAES-512 for scratchpad explode/implode, use it only when all 8 scratchpads of each thread fit in cache
+    if (intensity && has(FLAG_VAES) && has(FLAG_AVX512F) && (family == Algorithm::CN || family == Algorithm::CN_LITE || family == Algorithm::CN_PICO || family == Algorithm::CN_FEMTO) && (cacheHashes / PUs) >= 8) {
+        intensity = 8;
+
+        if (domain) {
+            domain->note("cache fits 8 scratchpads per thread, VAES-512 8-way mode");
+        }
+    }
+#   endif
+
 #   ifdef XMRIG_ALGO_RANDOMX
     if (extra == 0 && algorithm.l2() > 0) {
+        const size_t hashes = cacheHashes;
         cacheHashes = std::min<size_t>(std::max<size_t>(L2 / algorithm.l2(), cores.size()), cacheHashes);
+
+        if (domain && cacheHashes < hashes) {
+            domain->note("L2 fits %zu RandomX working sets, threads limited to %zu", L2 / algorithm.l2(), cacheHashes);
+        }
     }
 #   endif
 
-    if (limit > 0) {
-        cacheHashes = std::min(cacheHashes, limit);
+    if (limit > 0 && limit < cacheHashes) {
+        cacheHashes = limit;
+
+        if (domain) {
+            domain->note("max threads hint limits this cache to %zu threads", limit);
+        }
     }
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -371,14 +541,41 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
         intensity = 8;
         // Always 1 thread per core (it uses additional helper thread when possible)
         cacheHashes = std::min(cacheHashes, cores.size());
+
+        if (domain) {
+            domain->note("GhostRider runs 8 hashes per thread, one thread per core");
+        }
     }
 #   endif
 
+    if (domain) {
+        domain->intensity = intensity == 0 ? 1 : intensity;
+    }
+
+    const auto coreIntensity = [&](hwloc_obj_t core) {
+        return (hybrid && isEfficiency(core)) ? efficiencyIntensity(core, scratchpad, intensity) : intensity;
+    };
+
+    if (domain && hybrid && algorithm != Algorithm::GHOSTRIDER_RTM) {
+        const auto it = std::find_if(cores.begin(), cores.end(), isEfficiency);
+        if (it != cores.end() && coreIntensity(*it) != intensity) {
+            domain->note("E-cores use intensity %u, their share of the cluster L2 is smaller", coreIntensity(*it));
+        }
+    }
+
     if (cacheHashes >= PUs) {
         for (hwloc_obj_t core : cores) {
             const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
             for (hwloc_obj_t pu : units) {
-                threads.add(pu->os_index, intensity);
+                threads.add(pu->os_index, coreIntensity(core));
+            }
+        }
+
+        if (domain) {
+            domain->note("cache fits all %zu threads", PUs);
+
+            for (size_t i = first; i < threads.count(); ++i) {
+                domain->affinity.emplace_back(threads.data()[i].affinity());
             }
         }
 
@@ -388,6 +585,8 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     std::vector<std::pair<int64_t, int32_t>> threads_data;
     threads_data.reserve(cores.size());
 
+    const size_t totalPUs = PUs;
+
     size_t pu_id = 0;
     while (cacheHashes > 0 && PUs > 0) {
         bool allocated_pu = false;
@@ -403,7 +602,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
             PUs--;
 
             allocated_pu = true;
-            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+            threads_data.emplace_back(units[pu_id]->os_index, coreIntensity(core));
 
             if (cacheHashes == 0) {
                 break;
@@ -429,10 +628,48 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
         pu_id++;
         std::reverse(cores.begin(), cores.end());
     }
+
+    if (domain) {
+        domain->note("%zu of %zu threads used, physical cores are filled first", threads.count() - first, totalPUs);
+
+        for (size_t i = first; i < threads.count(); ++i) {
+            domain->affinity.emplace_back(threads.data()[i].affinity());
+        }
+    }
 #   endif
 }
 
 
+void xmrig::HwlocCpuInfo::setEfficiencyUnits()
+{
+    const unsigned depth = L3() > 0 ? 3 : 2;
+    hwloc_obj_t core     = nullptr;
+
+    while ((core = hwloc_get_next_obj_by_type(m_topology, HWLOC_OBJ_CORE, core)) != nullptr) {
+        hwloc_obj_t cache = findParentCache(core, depth);
+        bool hybrid       = false;
+
+        if (cache) {
+            const size_t PUs   = countInside(m_topology, cache, HWLOC_OBJ_PU);
+            const size_t cores = countInside(m_topology, cache, HWLOC_OBJ_CORE);
+
+            hybrid = (PUs > cores) && (PUs < cores * 2);
+        }
+
+        if (!isEfficiencyCore(core, hybrid)) {
+            continue;
+        }
+
+        hwloc_obj_t pu = nullptr;
+        while ((pu = hwloc_get_next_obj_inside_cpuset_by_type(m_topology, core->cpuset, HWLOC_OBJ_PU, pu)) != nullptr) {
+            m_efficiencyUnits.emplace_back(static_cast<int32_t>(pu->os_index));
+        }
+    }
+
+    std::sort(m_efficiencyUnits.begin(), m_efficiencyUnits.end());
+}
+
+
 void xmrig::HwlocCpuInfo::setThreads(size_t threads)
 {
     if (!threads) {
@@ -54,8 +54,11 @@ public:
     bool membind(hwloc_const_bitmap_t nodeset);
 
 protected:
+    CoreType coreType(int64_t affinity) const override;
+    CpuPlan plan(const Algorithm &algorithm, uint32_t limit) const override;
     CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
 
+    inline bool isHybrid() const override           { return !m_efficiencyUnits.empty() && m_efficiencyUnits.size() < m_threads; }
     inline const char *backend() const override     { return m_backend; }
     inline size_t cores() const override            { return m_cores; }
     inline size_t L2() const override               { return m_cache[2]; }
@@ -64,18 +67,24 @@ protected:
     inline size_t packages() const override         { return m_packages; }
 
 private:
+    bool isEfficiencyCore(hwloc_obj_t core, bool hybridCache) const;
+    uint32_t efficiencyIntensity(hwloc_obj_t core, size_t scratchpad, uint32_t intensity) const;
     CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit) const;
-    void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const;
+    CpuThreads threads(const Algorithm &algorithm, uint32_t limit, CpuPlan *plan) const;
+    void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit, CpuPlan::Domain *domain) const;
+    void setEfficiencyUnits();
     void setThreads(size_t threads);
 
     static uint32_t m_features;
 
     char m_backend[20]          = { 0 };
     hwloc_topology_t m_topology = nullptr;
+    int m_maxEfficiency         = -1;
     size_t m_cache[5]           = { 0 };
     size_t m_cores              = 0;
     size_t m_nodes              = 0;
     size_t m_packages           = 0;
+    std::vector<int32_t> m_efficiencyUnits;
     std::vector<uint32_t> m_nodeset;
 };
 
@@ -118,6 +118,8 @@ void OclKawPowRunner::set(const Job &job, uint8_t *blob)
 
     const uint32_t epoch = m_blockHeight / KPHash::EPOCH_LENGTH;
 
+    KPCache::prepare(m_blockHeight);
+
     const uint64_t dag_size = KPCache::dag_size(epoch);
     if (dag_size > m_dagCapacity) {
         OclLib::release(m_dag);
@@ -130,19 +132,20 @@ void OclKawPowRunner::set(const Job &job, uint8_t *blob)
         m_epoch = epoch;
 
         {
-            std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-
-            KPCache::s_cache.init(epoch);
+            const auto cache = KPCache::get(epoch);
+            if (!cache) {
+                throw std::runtime_error("KawPow light cache is not available");
+            }
 
-            if (KPCache::s_cache.size() > m_lightCacheCapacity) {
+            if (cache->size() > m_lightCacheCapacity) {
                 OclLib::release(m_lightCache);
 
-                m_lightCacheCapacity = VirtualMemory::align(KPCache::s_cache.size());
+                m_lightCacheCapacity = VirtualMemory::align(cache->size());
                 m_lightCache = OclLib::createBuffer(m_ctx, CL_MEM_READ_ONLY, m_lightCacheCapacity);
             }
 
-            m_lightCacheSize = KPCache::s_cache.size();
-            enqueueWriteBuffer(m_lightCache, CL_TRUE, 0, m_lightCacheSize, KPCache::s_cache.data());
+            m_lightCacheSize = cache->size();
+            enqueueWriteBuffer(m_lightCache, CL_TRUE, 0, m_lightCacheSize, cache->data());
         }
 
         const uint64_t start_ms = Chrono::steadyMSecs();
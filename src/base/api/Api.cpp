@@ -20,12 +20,16 @@
 
 
 #include "base/api/Api.h"
+#include "3rdparty/llhttp/llhttp.h"
+#include "base/api/ApiSnapshot.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
 #include "base/io/Env.h"
 #include "base/io/json/Json.h"
 #include "base/kernel/Base.h"
+#include "base/kernel/Startup.h"
+#include "base/net/http/HttpData.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -38,12 +42,17 @@
 #endif
 
 
+#include <iterator>
 #include <thread>
 
 
 namespace xmrig {
 
 
+// Read-only responses are reused for one miner tick, scrapers polling several endpoints don't rebuild them every time.
+static constexpr uint64_t kCacheTTL = 500;
+
+
 static rapidjson::Value getResources(rapidjson::Document &doc)
 {
     using namespace rapidjson;
@@ -98,9 +107,32 @@ xmrig::Api::~Api()
 
 void xmrig::Api::request(const HttpData &req)
 {
+    const uint64_t now = Chrono::steadyMSecs();
+
+    if (req.method != HTTP_GET) {
+        m_cache.clear();
+    }
+    else {
+        const auto it = m_cache.find(req.url);
+        if (it != m_cache.end() && now - it->second.ts < kCacheTTL) {
+            return HttpApiResponse(req.id()).end(it->second.body, it->second.etag, it->second.contentType);
+        }
+    }
+
     HttpApiRequest request(req, m_base->config()->http().isRestricted());
 
     exec(request);
+
+    const auto &response = request.response();
+    if (req.method != HTTP_GET || response.body().empty() || (response.statusCode() != 200 && response.statusCode() != 304)) {
+        return;
+    }
+
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        it = now - it->second.ts >= kCacheTTL ? m_cache.erase(it) : std::next(it);
+    }
+
+    m_cache[req.url] = { response.body(), response.etag(), response.contentType(), now };
 }
 
 
@@ -125,6 +157,8 @@ void xmrig::Api::stop()
 
 void xmrig::Api::onConfigChanged(Config *config, Config *previousConfig)
 {
+    m_cache.clear();
+
     if (config->apiId() != previousConfig->apiId()) {
         genId(config->apiId());
     }
@@ -150,6 +184,7 @@ void xmrig::Api::exec(IApiRequest &request)
         reply.AddMember("uptime",     (Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000, allocator);
         reply.AddMember("restricted", request.isRestricted(), allocator);
         reply.AddMember("resources",  getResources(request.doc()), allocator);
+        reply.AddMember("startup",    Startup::toJSON(request.doc()), allocator);
 
         Value features(kArrayType);
 #       ifdef XMRIG_FEATURE_API
@@ -175,6 +210,12 @@ void xmrig::Api::exec(IApiRequest &request)
 #       endif
         reply.AddMember("features", features, allocator);
     }
+    else if (request.type() == IApiRequest::REQ_SNAPSHOT) {
+        request.accept();
+
+        const uint64_t now = Chrono::currentMSecsSinceEpoch();
+        request.snapshot().begin(now, (now - m_timestamp) / 1000);
+    }
 
     for (IApiListener *listener : m_listeners) {
         listener->onRequest(request);
@@ -20,6 +20,8 @@
 #define XMRIG_API_H
 
 
+#include <map>
+#include <string>
 #include <vector>
 #include <cstdint>
 
@@ -59,6 +61,14 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    struct CacheEntry
+    {
+        std::string body;
+        std::string etag;
+        std::string contentType;
+        uint64_t ts;
+    };
+
     void exec(IApiRequest &request);
     void genId(const String &id);
     void genWorkerId(const String &id);
@@ -68,6 +78,7 @@ private:
     String m_workerId;
     const uint64_t m_timestamp;
     Httpd *m_httpd = nullptr;
+    std::map<std::string, CacheEntry> m_cache;
     std::vector<IApiListener *> m_listeners;
 };
 
@@ -0,0 +1,78 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/api/ApiSnapshot.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+void xmrig::ApiSnapshot::begin(uint64_t timestamp, uint64_t uptime)
+{
+    m_data.clear();
+    m_data.reserve(512);
+
+    put(kMagic);
+    put(kVersion);
+    put(static_cast<uint16_t>(0));
+    put(timestamp);
+    put(uptime);
+}
+
+
+void xmrig::ApiSnapshot::beginSection(Section section)
+{
+    uint16_t count = 0;
+    memcpy(&count, &m_data[6], sizeof(count));
+    ++count;
+    memcpy(&m_data[6], &count, sizeof(count));
+
+    m_section = m_data.size();
+
+    put(static_cast<uint16_t>(section));
+    put(static_cast<uint16_t>(0));
+    put(static_cast<uint32_t>(0));
+}
+
+
+void xmrig::ApiSnapshot::endSection()
+{
+    const auto size = static_cast<uint32_t>(m_data.size() - m_section - 8);
+    memcpy(&m_data[m_section + 4], &size, sizeof(size));
+}
+
+
+void xmrig::ApiSnapshot::put(const char *str, size_t size)
+{
+    const size_t len = str ? std::min(strlen(str), size) : 0;
+
+    if (len) {
+        append(str, len);
+    }
+
+    m_data.append(size - len, '\0');
+}
+
+
+void xmrig::ApiSnapshot::putHashrate(double value)
+{
+    put(std::isnormal(value) ? static_cast<float>(value) : std::numeric_limits<float>::quiet_NaN());
+}
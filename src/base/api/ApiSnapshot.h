@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_APISNAPSHOT_H
+#define XMRIG_APISNAPSHOT_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+namespace xmrig {
+
+
+// Fixed-layout binary form of the summary for fleet collectors (GET /2/snapshot), see doc/API.md for the layout.
+// A 24 byte header is followed by sections, each one is a 8 byte section header and its payload, integers are
+// little-endian and hashrates are float32 (NaN if not available yet). Decoders must skip unknown section types.
+class ApiSnapshot
+{
+public:
+    static constexpr uint32_t kMagic        = 0x53524d58; // "XMRS"
+    static constexpr uint16_t kVersion      = 1;
+
+    enum Section : uint16_t {
+        SECTION_HASHRATE = 1,
+        SECTION_RESULTS  = 2,
+        SECTION_BACKEND  = 3
+    };
+
+    inline bool isEmpty() const         { return m_data.empty(); }
+    inline std::string &data()          { return m_data; }
+
+    inline void put(float value)        { append(&value, sizeof(value)); }
+    inline void put(uint8_t value)      { append(&value, sizeof(value)); }
+    inline void put(uint16_t value)     { append(&value, sizeof(value)); }
+    inline void put(uint32_t value)     { append(&value, sizeof(value)); }
+    inline void put(uint64_t value)     { append(&value, sizeof(value)); }
+
+    void begin(uint64_t timestamp, uint64_t uptime);
+    void beginSection(Section section);
+    void endSection();
+    void put(const char *str, size_t size);
+    void putHashrate(double value);
+
+private:
+    inline void append(const void *data, size_t size) { m_data.append(static_cast<const char *>(data), size); }
+
+    size_t m_section = 0;
+    std::string m_data;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_APISNAPSHOT_H */
@@ -0,0 +1,153 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/api/EventStream.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/net/http/HttpContext.h"
+
+
+#include <deque>
+#include <iterator>
+#include <map>
+#include <string>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+class EventSubscriber
+{
+public:
+    std::deque<std::string> queue;
+    uint64_t dropped = 0;
+};
+
+
+static std::map<uint64_t, EventSubscriber> subscribers;
+static uint64_t sequence = 0;
+
+
+static std::string format(const char *event, const char *data)
+{
+    return "id: " + std::to_string(++sequence) + "\nevent: " + event + "\ndata: " + data + "\n\n";
+}
+
+
+static bool flush(uint64_t id, EventSubscriber &subscriber)
+{
+    HttpContext *ctx = HttpContext::get(id);
+    if (!ctx || uv_is_writable(ctx->stream()) != 1) {
+        return false;
+    }
+
+    if (subscriber.dropped && ctx->stream()->write_queue_size < EventStream::kMaxWriteQueue) {
+        ctx->write(format("dropped", ("{\"count\":" + std::to_string(subscriber.dropped) + "}").c_str()), false);
+        subscriber.dropped = 0;
+    }
+
+    while (!subscriber.queue.empty() && ctx->stream()->write_queue_size < EventStream::kMaxWriteQueue) {
+        ctx->write(std::move(subscriber.queue.front()), false);
+        subscriber.queue.pop_front();
+    }
+
+    return true;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::EventStream::isActive()
+{
+    return !subscribers.empty();
+}
+
+
+bool xmrig::EventStream::subscribe(const HttpData &req)
+{
+    HttpContext *ctx = HttpContext::get(req.id());
+    if (!ctx || subscribers.size() >= kMaxSubscribers) {
+        return false;
+    }
+
+    ctx->write("HTTP/1.1 200 OK\r\n"
+               "Content-Type: text/event-stream\r\n"
+               "Cache-Control: no-cache\r\n"
+               "Connection: keep-alive\r\n"
+               "Access-Control-Allow-Origin: *\r\n"
+               "\r\n"
+               "retry: 3000\n\n", false);
+
+    subscribers[req.id()];
+
+    return true;
+}
+
+
+void xmrig::EventStream::clear()
+{
+    subscribers.clear();
+}
+
+
+void xmrig::EventStream::publish(const char *event, const rapidjson::Value &value)
+{
+    using namespace rapidjson;
+
+    if (subscribers.empty()) {
+        return;
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    value.Accept(writer);
+
+    const std::string data = format(event, buffer.GetString());
+
+    for (auto it = subscribers.begin(); it != subscribers.end();) {
+        auto &subscriber = it->second;
+
+        if (subscriber.queue.size() >= kMaxQueue) {
+            subscriber.queue.pop_front();
+            ++subscriber.dropped;
+        }
+
+        subscriber.queue.emplace_back(data);
+
+        it = flush(it->first, subscriber) ? std::next(it) : subscribers.erase(it);
+    }
+}
+
+
+void xmrig::EventStream::tick()
+{
+    for (auto it = subscribers.begin(); it != subscribers.end();) {
+        auto &subscriber = it->second;
+
+        // Comment line, keeps proxies from timing out the stream and detects dead peers.
+        if (subscriber.queue.empty()) {
+            subscriber.queue.emplace_back(":\n\n");
+        }
+
+        it = flush(it->first, subscriber) ? std::next(it) : subscribers.erase(it);
+    }
+}
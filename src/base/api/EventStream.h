@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_EVENTSTREAM_H
+#define XMRIG_EVENTSTREAM_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class HttpData;
+
+
+// Server-sent events feed of the HTTP API (GET /2/events), main loop only.
+class EventStream
+{
+public:
+    static constexpr size_t kMaxSubscribers = 16;
+    static constexpr size_t kMaxQueue       = 256;          // events waiting per subscriber, the oldest are dropped first
+    static constexpr size_t kMaxWriteQueue  = 64 * 1024;    // bytes in flight per subscriber before events are kept queued
+
+    static bool isActive();
+    static bool subscribe(const HttpData &req);
+    static void clear();
+    static void publish(const char *event, const rapidjson::Value &value);
+    static void tick();
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_EVENTSTREAM_H */
@@ -19,10 +19,13 @@
 #include "base/api/Httpd.h"
 #include "3rdparty/llhttp/llhttp.h"
 #include "base/api/Api.h"
+#include "base/api/EventStream.h"
 #include "base/io/log/Log.h"
 #include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpContext.h"
 #include "base/net/http/HttpData.h"
 #include "base/net/tools/TcpServer.h"
+#include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 
@@ -92,7 +95,8 @@ bool xmrig::Httpd::start()
         return false;
     }
 
-    m_port = static_cast<uint16_t>(rc);
+    m_port  = static_cast<uint16_t>(rc);
+    m_timer = new Timer(this, HttpContext::kKeepAliveTimeout / 3, HttpContext::kKeepAliveTimeout / 3);
 
 #   ifdef _WIN32
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast, performance-no-int-to-ptr)
@@ -112,9 +116,13 @@ bool xmrig::Httpd::start()
 
 void xmrig::Httpd::stop()
 {
+    EventStream::clear();
+
+    delete m_timer;
     delete m_server;
     delete m_http;
 
+    m_timer  = nullptr;
     m_server = nullptr;
     m_http   = nullptr;
     m_port   = 0;
@@ -161,6 +169,14 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
         return HttpApiResponse(data.id(), status).end();
     }
 
+    if (data.method == HTTP_GET && data.url == "/2/events") {
+        if (!EventStream::subscribe(data)) {
+            return HttpApiResponse(data.id(), 503 /* SERVICE_UNAVAILABLE */).end();
+        }
+
+        return;
+    }
+
     if (data.method != HTTP_GET) {
         if (m_base->config()->http().isRestricted()) {
             return HttpApiResponse(data.id(), 403 /* FORBIDDEN */).end();
@@ -175,6 +191,13 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
 }
 
 
+void xmrig::Httpd::onTimer(const Timer *)
+{
+    HttpContext::closeIdle(HttpContext::kKeepAliveTimeout);
+    EventStream::tick();
+}
+
+
 int xmrig::Httpd::auth(const HttpData &req) const
 {
     const Http &config = m_base->config()->http();
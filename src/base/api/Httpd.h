@@ -21,6 +21,7 @@
 
 
 #include "base/kernel/interfaces/IBaseListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
 #include "base/net/http/HttpListener.h"
 #include "base/tools/Object.h"
 
@@ -36,9 +37,10 @@ class Base;
 class HttpServer;
 class HttpsServer;
 class TcpServer;
+class Timer;
 
 
-class Httpd : public IBaseListener, public IHttpListener
+class Httpd : public IBaseListener, public IHttpListener, public ITimerListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Httpd)
@@ -52,6 +54,7 @@ public:
 protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
     void onHttpData(const HttpData &data) override;
+    void onTimer(const Timer *timer) override;
 
 private:
     int auth(const HttpData &req) const;
@@ -59,6 +62,7 @@ private:
     const Base *m_base;
     std::shared_ptr<IHttpListener> m_httpListener;
     TcpServer *m_server     = nullptr;
+    Timer *m_timer          = nullptr;
     uint16_t m_port         = 0;
 
 #   ifdef XMRIG_FEATURE_TLS
@@ -27,6 +27,7 @@
 namespace xmrig {
 
 
+class ApiSnapshot;
 class String;
 
 
@@ -52,7 +53,8 @@ public:
     enum RequestType {
         REQ_UNKNOWN,
         REQ_SUMMARY,
-        REQ_JSON_RPC
+        REQ_JSON_RPC,
+        REQ_SNAPSHOT
     };
 
 
@@ -75,6 +77,7 @@ public:
     virtual const rapidjson::Value &json() const                        = 0;
     virtual const String &rpcMethod() const                             = 0;
     virtual const String &url() const                                   = 0;
+    virtual ApiSnapshot &snapshot()                                     = 0;
     virtual int version() const                                         = 0;
     virtual Method method() const                                       = 0;
     virtual rapidjson::Document &doc()                                  = 0;
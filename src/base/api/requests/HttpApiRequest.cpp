@@ -27,9 +27,10 @@
 namespace xmrig {
 
 
-static const char *kError  = "error";
-static const char *kId     = "id";
-static const char *kResult = "result";
+static const char *kError       = "error";
+static const char *kId          = "id";
+static const char *kOctetStream = "application/octet-stream";
+static const char *kResult      = "result";
 
 
 static inline const char *rpcError(int code) {
@@ -71,6 +72,9 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
         if (url() == "/1/summary" || url() == "/2/summary" || url() == "/api.json") {
             m_type = REQ_SUMMARY;
         }
+        else if (url() == "/2/snapshot") {
+            m_type = REQ_SNAPSHOT;
+        }
     }
 
     if (method() == METHOD_POST && url() == "/json_rpc") {
@@ -166,6 +170,10 @@ void xmrig::HttpApiRequest::done(int status)
     }
     else {
         m_res.setStatus(status);
+
+        if (type() == REQ_SNAPSHOT && status == 200) {
+            return m_res.end(std::move(m_snapshot.data()), kOctetStream);
+        }
     }
 
     m_res.end();
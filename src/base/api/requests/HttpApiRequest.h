@@ -21,6 +21,7 @@
 #define XMRIG_HTTPAPIREQUEST_H
 
 
+#include "base/api/ApiSnapshot.h"
 #include "base/api/requests/ApiRequest.h"
 #include "base/net/http/HttpApiResponse.h"
 #include "base/tools/String.h"
@@ -37,9 +38,12 @@ class HttpApiRequest : public ApiRequest
 public:
     HttpApiRequest(const HttpData &req, bool restricted);
 
+    inline const HttpApiResponse &response() const       { return m_res; }
+
 protected:
     inline bool hasParseError() const override           { return m_parsed == 2; }
     inline const String &url() const override            { return m_url; }
+    inline ApiSnapshot &snapshot() override               { return m_snapshot; }
     inline rapidjson::Document &doc() override           { return m_res.doc(); }
     inline rapidjson::Value &reply() override            { return m_res.doc(); }
 
@@ -56,6 +60,7 @@ private:
     const HttpData &m_req;
     HttpApiResponse m_res;
     int m_parsed = 0;
+    ApiSnapshot m_snapshot;
     rapidjson::Document m_body;
     String m_url;
 };
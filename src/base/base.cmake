@@ -13,6 +13,7 @@ set(HEADERS_BASE
     src/base/io/json/JsonRequest.h
     src/base/io/log/backends/ConsoleLog.h
     src/base/io/log/backends/FileLog.h
+    src/base/io/log/backends/JsonLog.h
     src/base/io/log/FileLogWriter.h
     src/base/io/log/Log.h
     src/base/io/log/Tags.h
@@ -43,6 +44,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/IWatcherListener.h
     src/base/kernel/Platform.h
     src/base/kernel/Process.h
+    src/base/kernel/Startup.h
     src/base/net/dns/Dns.h
     src/base/net/dns/DnsConfig.h
     src/base/net/dns/DnsRecord.h
@@ -102,6 +104,7 @@ set(SOURCES_BASE
     src/base/io/json/JsonRequest.cpp
     src/base/io/log/backends/ConsoleLog.cpp
     src/base/io/log/backends/FileLog.cpp
+    src/base/io/log/backends/JsonLog.cpp
     src/base/io/log/FileLogWriter.cpp
     src/base/io/log/Log.cpp
     src/base/io/log/Tags.cpp
@@ -114,6 +117,7 @@ set(SOURCES_BASE
     src/base/kernel/Entry.cpp
     src/base/kernel/Platform.cpp
     src/base/kernel/Process.cpp
+    src/base/kernel/Startup.cpp
     src/base/net/dns/Dns.cpp
     src/base/net/dns/DnsConfig.cpp
     src/base/net/dns/DnsRecord.cpp
@@ -189,6 +193,8 @@ if (WITH_HTTP)
     set(HEADERS_BASE_HTTP
         src/3rdparty/llhttp/llhttp.h
         src/base/api/Api.h
+        src/base/api/ApiSnapshot.h
+        src/base/api/EventStream.h
         src/base/api/Httpd.h
         src/base/api/interfaces/IApiRequest.h
         src/base/api/requests/ApiRequest.h
@@ -212,6 +218,8 @@ if (WITH_HTTP)
         src/3rdparty/llhttp/api.c
         src/3rdparty/llhttp/http.c
         src/base/api/Api.cpp
+        src/base/api/ApiSnapshot.cpp
+        src/base/api/EventStream.cpp
         src/base/api/Httpd.cpp
         src/base/api/requests/ApiRequest.cpp
         src/base/api/requests/HttpApiRequest.cpp
@@ -28,12 +28,20 @@
 namespace xmrig {
 
 
-static void fsWriteCallback(uv_fs_t *req)
+// Synchronous write, log backends are only called from the log writer thread, never from the main loop.
+static bool fsWrite(int file, int64_t &pos, const uv_buf_t *bufs, unsigned int count)
 {
-    delete [] static_cast<char *>(req->data);
+    uv_fs_t req{};
+    const int rc = uv_fs_write(uv_default_loop(), &req, file, bufs, count, pos, nullptr);
+    uv_fs_req_cleanup(&req);
 
-    uv_fs_req_cleanup(req);
-    delete req;
+    if (rc < 0) {
+        return false;
+    }
+
+    pos += rc;
+
+    return true;
 }
 
 
@@ -68,39 +76,43 @@ bool xmrig::FileLogWriter::open(const char *fileName)
 }
 
 
-bool xmrig::FileLogWriter::write(const char *data, size_t size)
+void xmrig::FileLogWriter::close()
 {
     if (!isOpen()) {
-        return false;
+        return;
     }
 
-    uv_buf_t buf = uv_buf_init(new char[size], size);
-    memcpy(buf.base, data, size);
+    uv_fs_t req{};
+    uv_fs_close(uv_default_loop(), &req, m_file, nullptr);
+    uv_fs_req_cleanup(&req);
 
-    auto req = new uv_fs_t;
-    req->data = buf.base;
+    m_file = -1;
+    m_pos  = 0;
+}
 
-    uv_fs_write(uv_default_loop(), req, m_file, &buf, 1, m_pos, fsWriteCallback);
-    m_pos += size;
 
-    return true;
+bool xmrig::FileLogWriter::write(const char *data, size_t size)
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+    const uv_buf_t buf = uv_buf_init(const_cast<char *>(data), size);
+
+    return fsWrite(m_file, m_pos, &buf, 1);
 }
 
 
 bool xmrig::FileLogWriter::writeLine(const char *data, size_t size)
 {
+    if (!isOpen()) {
+        return false;
+    }
+
     const uv_buf_t buf[2] = {
-        uv_buf_init(new char[size], size),
+        uv_buf_init(const_cast<char *>(data), size),
         uv_buf_init(const_cast<char *>(m_endl), sizeof(m_endl) - 1)
     };
 
-    memcpy(buf[0].base, data, size);
-
-    auto req = new uv_fs_t;
-    req->data = buf[0].base;
-
-    uv_fs_write(uv_default_loop(), req, m_file, buf, 2, m_pos, fsWriteCallback);
-    m_pos += (buf[0].len + buf[1].len);
-
-    return true;
+    return fsWrite(m_file, m_pos, buf, 2);
 }
@@ -37,6 +37,7 @@ public:
     inline int64_t pos() const  { return m_pos; }
 
     bool open(const char *fileName);
+    void close();
     bool write(const char *data, size_t size);
     bool writeLine(const char *data, size_t size);
 
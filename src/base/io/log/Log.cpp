@@ -24,18 +24,28 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdarg>
 #include <cstring>
 #include <ctime>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <uv.h>
 #include <vector>
 
 
 #include "base/io/log/Log.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
 #include "base/kernel/interfaces/ILogBackend.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/MpscQueue.h"
 #include "base/tools/Object.h"
 
 
@@ -58,70 +68,214 @@ static const char *colors_map[] = {
 };
 
 
+static const char *level_names[] = {
+    "emerg",
+    "alert",
+    "crit",
+    "error",
+    "warning",
+    "notice",
+    "info",
+    "debug"
+};
+
+
+// Small sequential id of the calling thread, stable for the lifetime of the process.
+static uint32_t threadId()
+{
+    static std::atomic<uint32_t> next{ 0 };
+    static thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+
+    return id;
+}
+
 
+class LogEntry
+{
+public:
+    inline LogEntry(uint64_t ts, Log::Level level, size_t offset, const char *line, size_t size, const char *type = nullptr) :
+        level(level),
+        type(type),
+        offset(offset),
+        ts(ts),
+        line(line, size)
+    {}
+
+    const Log::Level level;
+    const char *type;       // string literal, structured event if not null and line is a complete JSON object
+    const size_t offset;
+    const uint64_t ts;
+    const std::string line;
+};
+
+
+// Callers only format the line and push it to a lock-free queue, a single writer thread strips colours and feeds
+// the backends in batches, so a slow file, terminal or syslog never blocks a worker thread.
 class LogPrivate
 {
 public:
     XMRIG_DISABLE_COPY_MOVE(LogPrivate)
 
+    constexpr static size_t kQueueSize = 1024;
+    constexpr static size_t kBatchSize = 64;
+
 
-    LogPrivate() = default;
+    inline LogPrivate()
+    {
+        start();
+    }
 
 
     inline ~LogPrivate()
     {
+        stop();
+
+        while (drain()) {}
+
         for (auto backend : m_backends) {
             delete backend;
         }
     }
 
 
-    inline void add(ILogBackend *backend) { m_backends.push_back(backend); }
+    inline uint64_t dropped() const { return m_droppedTotal.load(std::memory_order_relaxed); }
 
 
-    void print(Log::Level level, const char *fmt, va_list args)
+    inline void add(ILogBackend *backend)
     {
-        size_t size   = 0;
-        size_t offset = 0;
+        std::lock_guard<std::mutex> lock(m_backendsMutex);
+
+        m_backends.push_back(backend);
+        m_hasBackends = true;
+    }
+
+
+    void event(Log::Level level, const char *type, const rapidjson::Value &fields)
+    {
+        using namespace rapidjson;
+
+        const uint64_t ts = Chrono::currentMSecsSinceEpoch();
+
+        StringBuffer buffer(nullptr, 512);
+        Writer<StringBuffer> writer(buffer);
+
+        writer.StartObject();
+        writer.Key("ts");
+        writer.Uint64(ts);
+        writer.Key("level");
+        writer.String(Log::levelName(level));
+        writer.Key("type");
+        writer.String(type);
+        writer.Key("thread");
+        writer.Uint(threadId());
+
+        if (fields.IsObject()) {
+            for (const auto &member : fields.GetObject()) {
+                writer.Key(member.name.GetString(), member.name.GetStringLength());
+                member.value.Accept(writer);
+            }
+        }
 
-        std::lock_guard<std::mutex> lock(m_mutex);
+        writer.EndObject();
+
+        push(new LogEntry(ts, level, 0, buffer.GetString(), buffer.GetSize(), type));
+    }
 
-        if (Log::isBackground() && m_backends.empty()) {
+
+    void print(Log::Level level, const char *fmt, va_list args)
+    {
+        if (Log::isBackground() && !m_hasBackends) {
             return;
         }
 
-        const uint64_t ts = timestamp(level, size, offset);
-        color(level, size);
+        LogEntry *entry = create(level, fmt, args);
+        if (entry) {
+            push(entry);
+        }
+    }
+
+
+    void push(LogEntry *entry)
+    {
+        if (!m_queue.push(entry)) {
+            delete entry;
+
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_droppedTotal.fetch_add(1, std::memory_order_relaxed);
 
-        const int rc = vsnprintf(m_buf + size, sizeof (m_buf) - offset - 32, fmt, args);
-        if (rc < 0) {
             return;
         }
 
-        size += std::min(static_cast<size_t>(rc), sizeof (m_buf) - offset - 32);
-        endl(size);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
 
-        std::string txt(m_buf);
-        size_t i = 0;
-        while ((i = txt.find(CSI)) != std::string::npos) {
-            txt.erase(i, txt.find('m', i) - i + 1);
+        if (m_waiting.load()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_one();
         }
+    }
 
-        if (!m_backends.empty()) {
-            for (auto backend : m_backends) {
-                backend->print(ts, level, m_buf, offset, size, true);
-                backend->print(ts, level, txt.c_str(), offset ? (offset - 11) : 0, txt.size(), false);
-            }
+
+    void start()
+    {
+        if (!m_thread.joinable()) {
+            m_stop   = false;
+            m_thread = std::thread(&LogPrivate::run, this);
         }
-        else {
-            fputs(txt.c_str(), stdout);
-            fflush(stdout);
+    }
+
+
+    void stop()
+    {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
         }
+
+        m_cv.notify_one();
+        m_thread.join();
     }
 
 
 private:
-    inline uint64_t timestamp(Log::Level level, size_t &size, size_t &offset)
+    static LogEntry *create(Log::Level level, const char *fmt, va_list args)
+    {
+        char buf[Log::kMaxBufferSize];
+        size_t size   = 0;
+        size_t offset = 0;
+
+        const uint64_t ts = timestamp(buf, level, size, offset);
+        color(buf, level, size);
+
+        const int rc = vsnprintf(buf + size, sizeof (buf) - offset - 32, fmt, args);
+        if (rc < 0) {
+            return nullptr;
+        }
+
+        size += std::min(static_cast<size_t>(rc), sizeof (buf) - offset - 32);
+        endl(buf, size);
+
+        return new LogEntry(ts, level, offset, buf, size);
+    }
+
+
+    static LogEntry *make(Log::Level level, const char *fmt, ...)
+    {
+        va_list args{};
+        va_start(args, fmt);
+
+        LogEntry *entry = create(level, fmt, args);
+
+        va_end(args);
+
+        return entry;
+    }
+
+
+    static inline uint64_t timestamp(char *buf, Log::Level level, size_t &size, size_t &offset)
     {
         const uint64_t ms = Chrono::currentMSecsSinceEpoch();
 
@@ -138,7 +292,7 @@ private:
         localtime_r(&now, &stime);
 #       endif
 
-        const int rc = snprintf(m_buf, sizeof(m_buf) - 1, "[%d-%02d-%02d %02d:%02d:%02d" BLACK_BOLD(".%03d") "] ",
+        const int rc = snprintf(buf, Log::kMaxBufferSize - 1, "[%d-%02d-%02d %02d:%02d:%02d" BLACK_BOLD(".%03d") "] ",
                                 stime.tm_year + 1900,
                                 stime.tm_mon + 1,
                                 stime.tm_mday,
@@ -156,7 +310,7 @@ private:
     }
 
 
-    inline void color(Log::Level level, size_t &size)
+    static inline void color(char *buf, Log::Level level, size_t &size)
     {
         if (level == Log::NONE) {
             return;
@@ -168,32 +322,150 @@ private:
         }
 
         const size_t s = strlen(color);
-        memcpy(m_buf + size, color, s);
+        memcpy(buf + size, color, s);
 
         size += s;
     }
 
 
-    inline void endl(size_t &size)
+    static inline void endl(char *buf, size_t &size)
     {
 #       ifdef _WIN32
-        memcpy(m_buf + size, CLEAR "\r\n", 7);
+        memcpy(buf + size, CLEAR "\r\n", 7);
         size += 6;
 #       else
-        memcpy(m_buf + size, CLEAR "\n", 6);
+        memcpy(buf + size, CLEAR "\n", 6);
         size += 5;
 #       endif
     }
 
 
-    char m_buf[Log::kMaxBufferSize]{};
+    // Single pass, every CSI sequence ends with 'm' in this codebase.
+    inline void strip(const std::string &line)
+    {
+        m_txt.clear();
+
+        const char *p   = line.data();
+        const char *end = p + line.size();
+
+        while (p < end) {
+            const char *esc = static_cast<const char *>(memchr(p, '\x1B', static_cast<size_t>(end - p)));
+            if (!esc) {
+                m_txt.append(p, static_cast<size_t>(end - p));
+                break;
+            }
+
+            m_txt.append(p, static_cast<size_t>(esc - p));
+
+            const char *m = static_cast<const char *>(memchr(esc, 'm', static_cast<size_t>(end - esc)));
+            p = m ? m + 1 : end;
+        }
+    }
+
+
+    void write(const LogEntry &entry)
+    {
+        if (entry.type) {
+            for (auto backend : m_backends) {
+                backend->event(entry.ts, entry.level, entry.type, entry.line.c_str(), entry.line.size());
+            }
+
+            return;
+        }
+
+        strip(entry.line);
+
+        if (m_backends.empty()) {
+            fputs(m_txt.c_str(), stdout);
+
+            return;
+        }
+
+        for (auto backend : m_backends) {
+            backend->print(entry.ts, entry.level, entry.line.c_str(), entry.offset, entry.line.size(), true);
+            backend->print(entry.ts, entry.level, m_txt.c_str(), entry.offset ? (entry.offset - 11) : 0, m_txt.size(), false);
+        }
+    }
+
+
+    size_t drain()
+    {
+        std::lock_guard<std::mutex> lock(m_backendsMutex);
+
+        size_t count = 0;
+        LogEntry *entry;
+
+        while (count < kBatchSize && (entry = m_queue.pop()) != nullptr) {
+            write(*entry);
+            delete entry;
+
+            ++count;
+        }
+
+        const uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped) {
+            entry = make(Log::WARNING, "log queue overflow, %" PRIu64 " messages dropped", dropped);
+            if (entry) {
+                write(*entry);
+                delete entry;
+
+                ++count;
+            }
+        }
+
+        if (count) {
+            for (auto backend : m_backends) {
+                backend->flush();
+            }
+
+            if (m_backends.empty()) {
+                fflush(stdout);
+            }
+        }
+
+        return count;
+    }
+
+
+    void run()
+    {
+        for (;;) {
+            if (drain()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_stop) {
+                break;
+            }
+
+            m_waiting = true;
+            m_cv.wait_for(lock, std::chrono::milliseconds(100), [this] { return m_stop || !m_queue.isEmpty(); });
+            m_waiting = false;
+        }
+
+        while (drain()) {}
+    }
+
+
+    bool m_stop                         = false;
+    MpscQueue<LogEntry, kQueueSize> m_queue;
+    std::atomic<bool> m_hasBackends     { false };
+    std::atomic<bool> m_waiting         { false };
+    std::atomic<uint64_t> m_dropped     { 0 };
+    std::atomic<uint64_t> m_droppedTotal{ 0 };
+    std::condition_variable m_cv;
+    std::mutex m_backendsMutex;
     std::mutex m_mutex;
+    std::string m_txt;
+    std::thread m_thread;
     std::vector<ILogBackend*> m_backends;
 };
 
 
 bool Log::m_background      = false;
 bool Log::m_colors          = true;
+bool Log::m_events          = false;
 LogPrivate *Log::d          = nullptr;
 uint32_t Log::m_verbose     = 0;
 
@@ -212,6 +484,18 @@ void xmrig::Log::add(ILogBackend *backend)
 }
 
 
+const char *xmrig::Log::levelName(int level)
+{
+    return (level >= EMERG && level <= DEBUG) ? level_names[level] : "none";
+}
+
+
+uint64_t xmrig::Log::dropped()
+{
+    return d ? d->dropped() : 0;
+}
+
+
 void xmrig::Log::destroy()
 {
     delete d;
@@ -219,12 +503,36 @@ void xmrig::Log::destroy()
 }
 
 
+void xmrig::Log::event(Level level, const char *type, const rapidjson::Value &fields)
+{
+    if (d && m_events) {
+        d->event(level, type, fields);
+    }
+}
+
+
 void xmrig::Log::init()
 {
     d = new LogPrivate();
 }
 
 
+void xmrig::Log::resume()
+{
+    if (d) {
+        d->start();
+    }
+}
+
+
+void xmrig::Log::suspend()
+{
+    if (d) {
+        d->stop();
+    }
+}
+
+
 void xmrig::Log::print(const char *fmt, ...)
 {
     if (!d) {
@@ -21,6 +21,9 @@
 #define XMRIG_LOG_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 #include <cstddef>
 #include <cstdint>
 
@@ -49,23 +52,31 @@ public:
 
     constexpr static size_t kMaxBufferSize = 16384;
 
+    static const char *levelName(int level);
+    static uint64_t dropped();
     static void add(ILogBackend *backend);
     static void destroy();
+    static void event(Level level, const char *type, const rapidjson::Value &fields);
     static void init();
     static void print(const char *fmt, ...);
     static void print(Level level, const char *fmt, ...);
+    static void resume();
+    static void suspend();
 
     static inline bool isBackground()                   { return m_background; }
     static inline bool isColors()                       { return m_colors; }
+    static inline bool isEvents()                       { return m_events; }
     static inline bool isVerbose()                      { return m_verbose > 0; }
     static inline uint32_t verbose()                    { return m_verbose; }
     static inline void setBackground(bool background)   { m_background = background; }
     static inline void setColors(bool colors)           { m_colors = colors; }
+    static inline void setEvents(bool events)           { m_events = events; }
     static inline void setVerbose(uint32_t verbose)     { m_verbose = verbose; }
 
 private:
     static bool m_background;
     static bool m_colors;
+    static bool m_events;
     static LogPrivate *d;
     static uint32_t m_verbose;
 };
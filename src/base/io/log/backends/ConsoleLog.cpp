@@ -85,11 +85,18 @@ void xmrig::ConsoleLog::print(uint64_t, int, const char *line, size_t, size_t si
     }
 #   else
     fputs(line, stdout);
-    fflush(stdout);
 #   endif
 }
 
 
+void xmrig::ConsoleLog::flush()
+{
+    if (m_tty) {
+        fflush(stdout);
+    }
+}
+
+
 bool xmrig::ConsoleLog::isSupported()
 {
     const uv_handle_type type = uv_guess_handle(1);
@@ -44,6 +44,9 @@ public:
     ~ConsoleLog() override;
 
 protected:
+    inline void event(uint64_t, int, const char *, const char *, size_t) override {}
+
+    void flush() override;
     void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
 
 private:
@@ -39,5 +39,16 @@ void xmrig::FileLog::print(uint64_t, int, const char *line, size_t, size_t size,
 
     assert(strlen(line) == size);
 
-    m_writer.write(line, size);
+    m_buffer.append(line, size);
+}
+
+
+void xmrig::FileLog::flush()
+{
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    m_writer.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
 }
@@ -25,6 +25,9 @@
 #include "base/kernel/interfaces/ILogBackend.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
@@ -34,10 +37,14 @@ public:
     FileLog(const char *fileName);
 
 protected:
+    inline void event(uint64_t, int, const char *, const char *, size_t) override {}
+
+    void flush() override;
     void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
 
 private:
     FileLogWriter m_writer;
+    std::string m_buffer;
 };
 
 
@@ -0,0 +1,148 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/io/log/backends/JsonLog.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/io/Env.h"
+#include "base/io/log/Log.h"
+
+
+#include <cstdio>
+#include <string>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+static void rename(const String &from, const String &to)
+{
+    uv_fs_t req{};
+    uv_fs_rename(uv_default_loop(), &req, from, to, nullptr);
+    uv_fs_req_cleanup(&req);
+}
+
+
+static String rotated(const String &fileName, int index)
+{
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%d", index);
+
+    return (std::string(fileName.data()) + suffix).c_str();
+}
+
+
+} // namespace xmrig
+
+
+xmrig::JsonLog::JsonLog(const char *fileName) :
+    m_fileName(Env::expand(fileName))
+{
+    m_writer.open(m_fileName);
+}
+
+
+void xmrig::JsonLog::event(uint64_t, int, const char *, const char *data, size_t size)
+{
+    m_buffer.append(data, size).push_back('\n');
+}
+
+
+void xmrig::JsonLog::flush()
+{
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    if (m_writer.pos() > 0 && m_writer.pos() + m_buffer.size() > kMaxSize) {
+        rotate();
+    }
+
+    m_writer.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+
+
+void xmrig::JsonLog::print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors)
+{
+    using namespace rapidjson;
+
+    if (colors || level < Log::EMERG || level > Log::WARNING || offset >= size) {
+        return;
+    }
+
+    // Tagged lines look like " net      message", the tag is the first word.
+    const char *msg = line + offset;
+    const char *end = line + size;
+    const char *tag = nullptr;
+    size_t tagSize  = 0;
+
+    while (end > msg && (end[-1] == '\n' || end[-1] == '\r')) {
+        --end;
+    }
+
+    if (*msg == ' ') {
+        tag = msg + 1;
+        while (tag + tagSize < end && tag[tagSize] != ' ') {
+            ++tagSize;
+        }
+
+        msg = tag + tagSize;
+        while (msg < end && *msg == ' ') {
+            ++msg;
+        }
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("ts");
+    writer.Uint64(timestamp);
+    writer.Key("level");
+    writer.String(Log::levelName(level));
+    writer.Key("type");
+    writer.String("log");
+
+    if (tagSize) {
+        writer.Key("tag");
+        writer.String(tag, static_cast<SizeType>(tagSize));
+    }
+
+    writer.Key("msg");
+    writer.String(msg, static_cast<SizeType>(end - msg));
+    writer.EndObject();
+
+    m_buffer.append(buffer.GetString(), buffer.GetSize()).push_back('\n');
+}
+
+
+void xmrig::JsonLog::rotate()
+{
+    m_writer.close();
+
+    for (int i = kMaxFiles - 1; i > 0; --i) {
+        rename(rotated(m_fileName, i), rotated(m_fileName, i + 1));
+    }
+
+    rename(m_fileName, rotated(m_fileName, 1));
+
+    m_writer.open(m_fileName);
+}
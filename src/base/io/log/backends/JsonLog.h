@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_JSONLOG_H
+#define XMRIG_JSONLOG_H
+
+
+#include "base/io/log/FileLogWriter.h"
+#include "base/kernel/interfaces/ILogBackend.h"
+#include "base/tools/String.h"
+
+
+#include <string>
+
+
+namespace xmrig {
+
+
+// One JSON object per line: structured events (share, job, dataset) and warnings or errors from the text log.
+class JsonLog : public ILogBackend
+{
+public:
+    constexpr static uint64_t kMaxSize  = 32 * 1024 * 1024;
+    constexpr static int kMaxFiles      = 3;   // rotated copies, file.1 is the newest
+
+    JsonLog(const char *fileName);
+
+protected:
+    void event(uint64_t timestamp, int level, const char *type, const char *data, size_t size) override;
+    void flush() override;
+    void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
+
+private:
+    void rotate();
+
+    FileLogWriter m_writer;
+    std::string m_buffer;
+    String m_fileName;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_JSONLOG_H */
@@ -25,12 +25,14 @@
 #include "base/io/json/JsonChain.h"
 #include "base/io/log/backends/ConsoleLog.h"
 #include "base/io/log/backends/FileLog.h"
+#include "base/io/log/backends/JsonLog.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/io/Watcher.h"
 #include "base/kernel/interfaces/IBaseListener.h"
 #include "base/kernel/Platform.h"
 #include "base/kernel/Process.h"
+#include "base/kernel/Startup.h"
 #include "base/net/tools/NetBuffer.h"
 #include "core/config/Config.h"
 #include "core/config/ConfigTransform.h"
@@ -73,7 +75,9 @@ public:
     {
         Log::init();
 
+        Startup::begin("config");
         config = load(process);
+        Startup::end("config");
     }
 
 
@@ -200,6 +204,11 @@ int xmrig::Base::init()
         Log::add(new FileLog(config()->logFile()));
     }
 
+    if (config()->logJson()) {
+        Log::add(new JsonLog(config()->logJson()));
+        Log::setEvents(true);
+    }
+
 #   ifdef HAVE_SYSLOG_H
     if (config()->isSyslog()) {
         Log::add(new SysLog());
@@ -23,7 +23,11 @@
  */
 
 
+#include <algorithm>
 #include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <thread>
 #include <uv.h>
 
 
@@ -40,6 +44,19 @@
 #   include "backend/opencl/wrappers/OclPlatform.h"
 #endif
 
+#ifdef XMRIG_FEATURE_TELEMETRY
+#   include "3rdparty/rapidjson/document.h"
+#   include "3rdparty/rapidjson/prettywriter.h"
+#   include "3rdparty/rapidjson/stringbuffer.h"
+#   include "hw/telemetry/CpuTelemetry.h"
+#endif
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "backend/common/benchmark/BenchSuite.h"
+#   include "backend/common/benchmark/CoreHealth.h"
+#endif
+
+#include "backend/cpu/Cpu.h"
 #include "base/kernel/Entry.h"
 #include "base/kernel/Process.h"
 #include "core/config/usage.h"
@@ -131,6 +148,131 @@ static int exportTopology(const Process &)
 #endif
 
 
+static int printPlan(const Process &process)
+{
+    const Arguments &args = process.arguments();
+    const char *hint      = args.value("--cpu-max-threads-hint");
+    const char *algo      = args.value("-a", "--algo");
+    const uint32_t limit  = hint ? static_cast<uint32_t>(std::min(std::max(atoi(hint), 1), 100)) : 100;
+
+    std::vector<Algorithm> algorithms;
+
+    if (algo) {
+        const Algorithm algorithm(algo);
+        if (!algorithm.isValid()) {
+            printf("unknown algorithm \"%s\"\n", algo);
+
+            return 1;
+        }
+
+        algorithms.emplace_back(algorithm);
+    }
+    else {
+        // First algorithm of every CPU family
+        std::set<uint32_t> families;
+
+        algorithms = Algorithm::all([&families](const Algorithm &algorithm) {
+            return algorithm.family() != Algorithm::KAWPOW && families.insert(algorithm.family()).second;
+        });
+    }
+
+    for (const Algorithm &algorithm : algorithms) {
+        Cpu::info()->plan(algorithm, limit).print();
+        printf("\n");
+    }
+
+    Cpu::release();
+
+    return 0;
+}
+
+
+#ifdef XMRIG_FEATURE_TELEMETRY
+static int printHealth()
+{
+    {
+        CpuTelemetry telemetry;
+        telemetry.sample();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        telemetry.sample();
+
+        rapidjson::Document doc(rapidjson::kObjectType);
+        rapidjson::Value value = telemetry.toJSON(doc);
+
+        rapidjson::StringBuffer buffer(nullptr, 4096);
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        writer.SetIndent(' ', 2);
+        value.Accept(writer);
+
+        printf("%s\n", buffer.GetString());
+    }
+
+    Cpu::release();
+
+    return 0;
+}
+#endif
+
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+static int checkCoreHealth(const Process &process)
+{
+    const Arguments &args = process.arguments();
+    const char *algo      = args.value("-a", "--algo");
+    const char *rounds    = args.value("--core-health-rounds");
+
+    const Algorithm algorithm(algo ? algo : "rx/0");
+    if (!algorithm.isValid()) {
+        printf("unknown algorithm \"%s\"\n", algo);
+
+        return 1;
+    }
+
+    const int rc = CoreHealth::exec(algorithm, rounds ? static_cast<uint32_t>(std::min(std::max(atoi(rounds), 1), 1000)) : CoreHealth::kRounds);
+
+    Cpu::release();
+
+    return rc;
+}
+
+
+static int runBenchSuite(const Process &process)
+{
+    const Arguments &args = process.arguments();
+    const char *algo      = args.value("-a", "--algo");
+    const char *repeats   = args.value("--bench-suite-repeats");
+    const char *time      = args.value("--bench-suite-time");
+    const char *out       = args.value("--bench-suite-out");
+
+    std::vector<Algorithm> algorithms;
+
+    if (algo) {
+        const Algorithm algorithm(algo);
+        if (!algorithm.isValid() || algorithm.family() == Algorithm::KAWPOW) {
+            printf("unknown algorithm \"%s\"\n", algo);
+
+            return 1;
+        }
+
+        algorithms.emplace_back(algorithm);
+    }
+    else {
+        algorithms = BenchSuite::algorithms();
+    }
+
+    const int rc = BenchSuite::exec(algorithms,
+                                    repeats ? static_cast<uint32_t>(std::min(std::max(atoi(repeats), 1), 100)) : BenchSuite::kRepeats,
+                                    time ? static_cast<uint32_t>(std::min(std::max(atoi(time), 1), 3600)) : BenchSuite::kTime,
+                                    out ? String(out) : Process::location(Process::ExeLocation, "bench-suite.json")
+                                    );
+
+    Cpu::release();
+
+    return rc;
+}
+#endif
+
+
 } // namespace xmrig
 
 
@@ -157,6 +299,26 @@ xmrig::Entry::Id xmrig::Entry::get(const Process &process)
     }
 #   endif
 
+    if (args.hasArg("--print-plan")) {
+        return Plan;
+    }
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    if (args.hasArg("--health")) {
+        return Health;
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (args.hasArg("--core-health")) {
+        return CoreHealth;
+    }
+
+    if (args.hasArg("--bench-suite")) {
+        return BenchSuite;
+    }
+#   endif
+
     return Default;
 }
 
@@ -184,6 +346,22 @@ int xmrig::Entry::exec(const Process &process, Id id)
         return 0;
 #   endif
 
+    case Plan:
+        return printPlan(process);
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    case Health:
+        return printHealth();
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    case CoreHealth:
+        return checkCoreHealth(process);
+
+    case BenchSuite:
+        return runBenchSuite(process);
+#   endif
+
     default:
         break;
     }
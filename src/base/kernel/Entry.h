@@ -40,7 +40,11 @@ public:
         Usage,
         Version,
         Topo,
-        Platforms
+        Platforms,
+        Plan,
+        Health,
+        CoreHealth,
+        BenchSuite
     };
 
     static Id get(const Process &process);
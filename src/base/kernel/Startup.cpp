@@ -0,0 +1,167 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/kernel/Startup.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+struct StartupEntry
+{
+    const char *name;
+    uint64_t start;
+    uint64_t end;
+    bool phase;
+    bool done;
+};
+
+
+static const uint64_t startTs = Chrono::steadyMSecs();
+static std::atomic<bool> completed{ false };
+static std::mutex mutex;
+static std::vector<StartupEntry> entries;
+
+
+static StartupEntry *find(const char *name)
+{
+    for (auto &entry : entries) {
+        if (strcmp(entry.name, name) == 0) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::Startup::isComplete()
+{
+    return completed.load(std::memory_order_relaxed);
+}
+
+
+rapidjson::Value xmrig::Startup::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Value out(kObjectType);
+    Value phases(kArrayType);
+    Value marks(kObjectType);
+
+    for (const auto &entry : entries) {
+        if (!entry.phase) {
+            marks.AddMember(StringRef(entry.name), entry.start, allocator);
+
+            continue;
+        }
+
+        Value phase(kObjectType);
+        phase.AddMember("name",     StringRef(entry.name), allocator);
+        phase.AddMember("start",    entry.start, allocator);
+        phase.AddMember("duration", entry.done ? Value(entry.end - entry.start) : Value(kNullType), allocator);
+
+        phases.PushBack(phase, allocator);
+    }
+
+    out.AddMember("complete",   isComplete(), allocator);
+    out.AddMember("phases",     phases, allocator);
+    out.AddMember("marks",      marks, allocator);
+
+    return out;
+}
+
+
+uint64_t xmrig::Startup::elapsed()
+{
+    return Chrono::steadyMSecs() - startTs;
+}
+
+
+void xmrig::Startup::begin(const char *phase)
+{
+    if (isComplete()) {
+        return;
+    }
+
+    const uint64_t ts = elapsed();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!find(phase)) {
+        entries.push_back({ phase, ts, ts, true, false });
+    }
+}
+
+
+void xmrig::Startup::complete(const char *mark)
+{
+    if (isComplete()) {
+        return;
+    }
+
+    Startup::mark(mark);
+    completed = true;
+}
+
+
+void xmrig::Startup::end(const char *phase)
+{
+    if (isComplete()) {
+        return;
+    }
+
+    const uint64_t ts = elapsed();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto entry = find(phase);
+    if (entry) {
+        entry->end  = std::max(entry->end, ts);
+        entry->done = true;
+    }
+}
+
+
+void xmrig::Startup::mark(const char *mark)
+{
+    if (isComplete()) {
+        return;
+    }
+
+    const uint64_t ts = elapsed();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!find(mark)) {
+        entries.push_back({ mark, ts, ts, false, true });
+    }
+}
@@ -0,0 +1,52 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_STARTUP_H
+#define XMRIG_STARTUP_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Startup timeline, milliseconds since process start. Thread safe, names must be string literals.
+// A phase spans from its first begin() to its last end(), so per thread work (e.g. workers) is recorded as one phase.
+// Marks keep the first time only; the timeline is frozen once complete() is called.
+class Startup
+{
+public:
+    static bool isComplete();
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static uint64_t elapsed();
+    static void begin(const char *phase);
+    static void complete(const char *mark);
+    static void end(const char *phase);
+    static void mark(const char *mark);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_STARTUP_H */
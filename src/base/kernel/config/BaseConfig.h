@@ -49,6 +49,7 @@ public:
     static const char *kDryRun;
     static const char *kHttp;
     static const char *kLogFile;
+    static const char *kLogJson;
     static const char *kPrintTime;
     static const char *kSyslog;
     static const char *kTitle;
@@ -67,6 +68,7 @@ public:
     inline bool isDryRun() const                            { return m_dryRun; }
     inline bool isSyslog() const                            { return m_syslog; }
     inline const char *logFile() const                      { return m_logFile.data(); }
+    inline const char *logJson() const                      { return m_logJson.data(); }
     inline const char *userAgent() const                    { return m_userAgent.data(); }
     inline const Http &http() const                         { return m_http; }
     inline const Pools &pools() const                       { return m_pools; }
@@ -101,6 +103,7 @@ protected:
     String m_apiWorkerId;
     String m_fileName;
     String m_logFile;
+    String m_logJson;
     String m_userAgent;
     Title m_title;
     uint32_t m_printTime    = 60;
@@ -198,6 +198,9 @@ void xmrig::BaseTransform::transform(rapidjson::Document &doc, int key, const ch
     case IConfig::LogFileKey: /* --log-file */
         return set(doc, BaseConfig::kLogFile, arg);
 
+    case IConfig::LogJsonKey: /* --log-json */
+        return set(doc, BaseConfig::kLogJson, arg);
+
     case IConfig::HttpAccessTokenKey: /* --http-access-token */
         m_http = true;
         return set(doc, BaseConfig::kHttp, Http::kToken, arg);
@@ -113,6 +113,14 @@ public:
         YieldKey             = 1030,
         AstroBWTMaxSizeKey   = 1034,
         AstroBWTAVX2Key      = 1036,
+        AstroBWTSortKey      = 1059,
+        CPUWatchdogKey       = 1060,
+        CPUWatchdogRestartKey = 1061,
+        CPUEfficiencyKey     = 1062,
+        CPUEfficiencyPowerLimitKey = 1063,
+        RandomXMsrExploreKey = 1064,
+        LogJsonKey           = 1065,
+        CPUSelfTestPerThreadKey = 1066,
         Argon2ImplKey        = 1039,
         RandomXCacheQoSKey   = 1040,
 
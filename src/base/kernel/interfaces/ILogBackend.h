@@ -38,6 +38,8 @@ public:
     ILogBackend()           = default;
     virtual ~ILogBackend()  = default;
 
+    virtual void event(uint64_t timestamp, int level, const char *type, const char *data, size_t size)           = 0;
+    virtual void flush()                                                                                        = 0;
     virtual void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) = 0;
 };
 
@@ -21,27 +21,32 @@
 #include "base/net/http/HttpApiResponse.h"
 #include "3rdparty/rapidjson/prettywriter.h"
 #include "3rdparty/rapidjson/stringbuffer.h"
-#include "base/net/http/HttpData.h"
+#include "base/crypto/keccak.h"
+#include "base/net/http/HttpContext.h"
+#include "base/tools/Cvt.h"
 
 
 namespace xmrig {
 
-static const char *kError  = "error";
-static const char *kStatus = "status";
+static const char *kError       = "error";
+static const char *kIfNoneMatch = "if-none-match";
+static const char *kStatus      = "status";
 
 } // namespace xmrig
 
 
 xmrig::HttpApiResponse::HttpApiResponse(uint64_t id) :
     HttpResponse(id),
-    m_doc(rapidjson::kObjectType)
+    m_doc(rapidjson::kObjectType),
+    m_contentType(HttpData::kApplicationJson)
 {
 }
 
 
 xmrig::HttpApiResponse::HttpApiResponse(uint64_t id, int status) :
     HttpResponse(id),
-    m_doc(rapidjson::kObjectType)
+    m_doc(rapidjson::kObjectType),
+    m_contentType(HttpData::kApplicationJson)
 {
     setStatus(status);
 }
@@ -51,10 +56,6 @@ void xmrig::HttpApiResponse::end()
 {
     using namespace rapidjson;
 
-    setHeader("Access-Control-Allow-Origin", "*");
-    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
-    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
-
     if (statusCode() >= 400) {
         if (!m_doc.HasMember(kStatus)) {
             m_doc.AddMember(StringRef(kStatus), statusCode(), m_doc.GetAllocator());
@@ -65,18 +66,80 @@ void xmrig::HttpApiResponse::end()
         }
     }
 
-    if (!m_doc.MemberCount()) {
+    if (m_doc.MemberCount()) {
+        StringBuffer buffer(nullptr, 4096);
+        PrettyWriter<StringBuffer> writer(buffer);
+        writer.SetMaxDecimalPlaces(10);
+        writer.SetFormatOptions(kFormatSingleLineArray);
+
+        m_doc.Accept(writer);
+
+        m_body.assign(buffer.GetString(), buffer.GetSize());
+        m_etag = makeETag(m_body);
+    }
+
+    send();
+}
+
+
+void xmrig::HttpApiResponse::end(std::string &&body, const std::string &contentType)
+{
+    m_body        = std::move(body);
+    m_etag        = makeETag(m_body);
+    m_contentType = contentType;
+
+    send();
+}
+
+
+void xmrig::HttpApiResponse::end(const std::string &body, const std::string &etag, const std::string &contentType)
+{
+    m_body        = body;
+    m_etag        = etag;
+    m_contentType = contentType;
+
+    send();
+}
+
+
+std::string xmrig::HttpApiResponse::makeETag(const std::string &body)
+{
+    uint8_t hash[200];
+    keccak(body.data(), body.size(), hash);
+
+    return "\"" + std::string(Cvt::toHex(hash, 8).data()) + "\"";
+}
+
+
+void xmrig::HttpApiResponse::send()
+{
+    setHeader("Access-Control-Allow-Origin", "*");
+    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
+    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
+
+    if (m_body.empty()) {
         return HttpResponse::end();
     }
 
-    setHeader(HttpData::kContentType, HttpData::kApplicationJson);
+    setHeader(HttpData::kContentType, m_contentType);
+
+    if (statusCode() != 200) {
+        return HttpResponse::end(m_body.data(), m_body.size());
+    }
 
-    StringBuffer buffer(nullptr, 4096);
-    PrettyWriter<StringBuffer> writer(buffer);
-    writer.SetMaxDecimalPlaces(10);
-    writer.SetFormatOptions(kFormatSingleLineArray);
+    setHeader("ETag", m_etag);
+    setHeader("Cache-Control", "no-cache");
 
-    m_doc.Accept(writer);
+    const HttpContext *ctx = HttpContext::get(id());
+    if (ctx && ctx->headers.count(kIfNoneMatch)) {
+        const std::string &match = ctx->headers.at(kIfNoneMatch);
+
+        if (match == "*" || match.find(m_etag) != std::string::npos) {
+            setStatus(304 /* NOT_MODIFIED */);
+
+            return HttpResponse::end();
+        }
+    }
 
-    HttpResponse::end(buffer.GetString(), buffer.GetSize());
+    HttpResponse::end(m_body.data(), m_body.size());
 }
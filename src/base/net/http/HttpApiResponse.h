@@ -25,6 +25,9 @@
 #include "base/net/http/HttpResponse.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
@@ -34,12 +37,24 @@ public:
     HttpApiResponse(uint64_t id);
     HttpApiResponse(uint64_t id, int status);
 
-    inline rapidjson::Document &doc() { return m_doc; }
+    inline const std::string &body() const          { return m_body; }
+    inline const std::string &contentType() const   { return m_contentType; }
+    inline const std::string &etag() const          { return m_etag; }
+    inline rapidjson::Document &doc()               { return m_doc; }
 
     void end();
+    void end(std::string &&body, const std::string &contentType);
+    void end(const std::string &body, const std::string &etag, const std::string &contentType);
 
 private:
+    static std::string makeETag(const std::string &body);
+
+    void send();
+
     rapidjson::Document m_doc;
+    std::string m_body;
+    std::string m_contentType;
+    std::string m_etag;
 };
 
 
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <uv.h>
+#include <vector>
 
 
 namespace xmrig {
@@ -35,6 +36,7 @@ namespace xmrig {
 static llhttp_settings_t http_settings;
 static std::map<uint64_t, HttpContext *> storage;
 static uint64_t SEQUENCE = 0;
+static constexpr size_t kMaxPipelineSize = 64 * 1024;
 
 
 class HttpWriteBaton : public Baton<uv_write_t>
@@ -124,7 +126,22 @@ bool xmrig::HttpContext::parse(const char *data, size_t size)
         return true;
     }
 
-    return llhttp_execute(m_parser, data, size) == HPE_OK;
+    // Pipelined requests wait here until the response to the current one is written.
+    if (m_paused) {
+        m_pipeline.append(data, size);
+
+        return m_pipeline.size() <= kMaxPipelineSize;
+    }
+
+    const llhttp_errno_t rc = llhttp_execute(m_parser, data, size);
+    if (rc == HPE_PAUSED) {
+        const char *pos = llhttp_get_error_pos(m_parser);
+        m_pipeline.assign(pos, static_cast<size_t>(data + size - pos));
+
+        return true;
+    }
+
+    return rc == HPE_OK;
 }
 
 
@@ -173,6 +190,32 @@ void xmrig::HttpContext::close(int status)
 }
 
 
+void xmrig::HttpContext::resume()
+{
+    m_pending = false;
+
+    if (!m_keepAlive) {
+        return;
+    }
+
+    m_idle = Chrono::steadyMSecs();
+
+    if (!m_paused) {
+        return;
+    }
+
+    m_paused = false;
+    llhttp_resume(m_parser);
+
+    std::string data;
+    data.swap(m_pipeline);
+
+    if (!parse(data.data(), data.size())) {
+        close();
+    }
+}
+
+
 xmrig::HttpContext *xmrig::HttpContext::get(uint64_t id)
 {
     const auto it = storage.find(id);
@@ -191,6 +234,23 @@ void xmrig::HttpContext::closeAll()
 }
 
 
+void xmrig::HttpContext::closeIdle(uint64_t timeout)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+    std::vector<HttpContext *> idle;
+
+    for (auto &kv : storage) {
+        if (kv.second->m_idle && now - kv.second->m_idle >= timeout) {
+            idle.emplace_back(kv.second);
+        }
+    }
+
+    for (auto ctx : idle) {
+        ctx->close();
+    }
+}
+
+
 int xmrig::HttpContext::onHeaderField(llhttp_t *parser, const char *at, size_t length)
 {
     auto ctx = static_cast<HttpContext*>(parser->data);
@@ -227,11 +287,16 @@ int xmrig::HttpContext::onHeaderValue(llhttp_t *parser, const char *at, size_t l
 
 void xmrig::HttpContext::attach(llhttp_settings_t *settings)
 {
-    settings->on_message_begin  = nullptr;
     settings->on_status         = nullptr;
     settings->on_chunk_header   = nullptr;
     settings->on_chunk_complete = nullptr;
 
+    settings->on_message_begin = [](llhttp_t *parser) -> int
+    {
+        static_cast<HttpContext*>(parser->data)->reset();
+        return 0;
+    };
+
     settings->on_url = [](llhttp_t *parser, const char *at, size_t length) -> int
     {
         static_cast<HttpContext*>(parser->data)->url = std::string(at, length);
@@ -268,16 +333,45 @@ void xmrig::HttpContext::attach(llhttp_settings_t *settings)
         auto ctx      = static_cast<HttpContext*>(parser->data);
         auto listener = ctx->httpListener();
 
-        if (listener) {
-            listener->onHttpData(*ctx);
+        if (!listener) {
+            return 0;
+        }
+
+        ctx->m_keepAlive = parser->type == HTTP_REQUEST && llhttp_should_keep_alive(parser) == 1;
+        ctx->m_pending   = true;
+
+        listener->onHttpData(*ctx);
+
+        if (!ctx->m_keepAlive) {
             ctx->m_listener.reset();
         }
+        else if (ctx->m_pending) {
+            ctx->m_paused = true;
+
+            return HPE_PAUSED;
+        }
 
         return 0;
     };
 }
 
 
+void xmrig::HttpContext::reset()
+{
+    url.clear();
+    body.clear();
+    headers.clear();
+
+    status           = 0;
+    m_wasHeaderValue = false;
+    m_idle           = 0;
+    m_timestamp      = Chrono::steadyMSecs();
+
+    m_lastHeaderField.clear();
+    m_lastHeaderValue.clear();
+}
+
+
 void xmrig::HttpContext::setHeader()
 {
     std::transform(m_lastHeaderField.begin(), m_lastHeaderField.end(), m_lastHeaderField.begin(), ::tolower);
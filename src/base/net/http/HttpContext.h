@@ -48,11 +48,14 @@ class HttpContext : public HttpData
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpContext)
 
+    static constexpr uint64_t kKeepAliveTimeout = 15000;
+
     HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener);
     ~HttpContext() override;
 
     inline uv_stream_t *stream() const { return reinterpret_cast<uv_stream_t *>(m_tcp); }
     inline uv_handle_t *handle() const { return reinterpret_cast<uv_handle_t *>(m_tcp); }
+    inline bool isKeepAlive() const    { return m_keepAlive; }
 
     inline const char *host() const override            { return nullptr; }
     inline const char *tlsFingerprint() const override  { return nullptr; }
@@ -66,9 +69,11 @@ public:
     std::string ip() const override;
     uint64_t elapsed() const;
     void close(int status = 0);
+    void resume();
 
     static HttpContext *get(uint64_t id);
     static void closeAll();
+    static void closeIdle(uint64_t timeout);
 
 protected:
     uv_tcp_t *m_tcp;
@@ -80,13 +85,19 @@ private:
     static int onHeaderValue(llhttp_t *parser, const char *at, size_t length);
     static void attach(llhttp_settings_t *settings);
 
+    void reset();
     void setHeader();
 
+    bool m_keepAlive                = false;
+    bool m_paused                   = false;
+    bool m_pending                  = false;
     bool m_wasHeaderValue           = false;
-    const uint64_t m_timestamp;
     llhttp_t *m_parser;
     std::string m_lastHeaderField;
     std::string m_lastHeaderValue;
+    std::string m_pipeline;
+    uint64_t m_idle                 = 0;
+    uint64_t m_timestamp;
     std::weak_ptr<IHttpListener> m_listener;
 };
 
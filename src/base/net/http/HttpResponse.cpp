@@ -65,11 +65,20 @@ void xmrig::HttpResponse::end(const char *data, size_t size)
         size = strlen(data);
     }
 
-    if (size) {
+    auto ctx             = HttpContext::get(m_id);
+    const bool keepAlive = ctx->isKeepAlive();
+
+    if (size || (keepAlive && statusCode() != 204 && statusCode() != 304)) {
         setHeader("Content-Length", std::to_string(size));
     }
 
-    setHeader("Connection", "close");
+    if (keepAlive) {
+        setHeader("Connection", "keep-alive");
+        setHeader("Keep-Alive", "timeout=" + std::to_string(HttpContext::kKeepAliveTimeout / 1000));
+    }
+    else {
+        setHeader("Connection", "close");
+    }
 
     std::stringstream ss;
     ss << "HTTP/1.1 " << statusCode() << " " << HttpData::statusName(statusCode()) << kCRLF;
@@ -80,7 +89,6 @@ void xmrig::HttpResponse::end(const char *data, size_t size)
 
     ss << kCRLF;
 
-    auto ctx         = HttpContext::get(m_id);
     std::string body = data ? (ss.str() + std::string(data, size)) : ss.str();
 
 #   ifndef APP_DEBUG
@@ -101,5 +109,6 @@ void xmrig::HttpResponse::end(const char *data, size_t size)
                    );
     }
 
-    ctx->write(std::move(body), true);
+    ctx->write(std::move(body), !keepAlive);
+    ctx->resume();
 }
@@ -33,6 +33,7 @@ class HttpResponse
 public:
     HttpResponse(uint64_t id, int statusCode = 200);
 
+    inline uint64_t id() const                                              { return m_id; }
     inline int statusCode() const                                           { return m_statusCode; }
     inline void setHeader(const std::string &key, const std::string &value) { m_headers.insert({ key, value }); }
     inline void setStatus(int code)                                         { m_statusCode = code; }
@@ -27,6 +27,11 @@
 #include "base/tools/Chrono.h"
 
 
+#ifdef XMRIG_FEATURE_API
+#   include "base/api/ApiSnapshot.h"
+#endif
+
+
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
@@ -174,6 +179,21 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
 
     return results;
 }
+
+
+void xmrig::NetworkState::getResults(ApiSnapshot &snapshot) const
+{
+    snapshot.beginSection(ApiSnapshot::SECTION_RESULTS);
+    snapshot.put(m_diff);
+    snapshot.put(m_accepted);
+    snapshot.put(m_rejected);
+    snapshot.put(m_hashes);
+    snapshot.put(avgTime());
+    snapshot.put(m_topDiff[0]);
+    snapshot.put(latency());
+    snapshot.put(static_cast<uint32_t>(m_failures));
+    snapshot.endSection();
+}
 #endif
 
 
@@ -33,6 +33,9 @@
 namespace xmrig {
 
 
+class ApiSnapshot;
+
+
 class NetworkState : public StrategyProxy
 {
 public:
@@ -45,6 +48,7 @@ public:
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value getConnection(rapidjson::Document &doc, int version) const;
     rapidjson::Value getResults(rapidjson::Document &doc, int version) const;
+    void getResults(ApiSnapshot &snapshot) const;
 #   endif
 
     void printConnection() const;
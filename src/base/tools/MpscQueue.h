@@ -0,0 +1,120 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_MPSCQUEUE_H
+#define XMRIG_MPSCQUEUE_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Bounded lock-free queue of pointers, any number of producers and a single consumer (D. Vyukov's bounded queue).
+// push() never blocks, it fails if the queue is full.
+template<typename T, size_t N>
+class MpscQueue
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue size must be a power of 2");
+
+public:
+    XMRIG_DISABLE_COPY_MOVE(MpscQueue)
+
+    MpscQueue()
+    {
+        for (size_t i = 0; i < N; ++i) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_cells[m_tail & (N - 1)].seq.load(std::memory_order_acquire) != m_tail + 1;
+    }
+
+    bool push(T *value)
+    {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+
+        for (;;) {
+            cell = &m_cells[pos & (N - 1)];
+
+            const size_t seq    = cell->seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer thread only.
+    T *pop()
+    {
+        Cell *cell = &m_cells[m_tail & (N - 1)];
+        if (cell->seq.load(std::memory_order_acquire) != m_tail + 1) {
+            return nullptr;
+        }
+
+        T *value = cell->value;
+        cell->seq.store(m_tail + N, std::memory_order_release);
+        ++m_tail;
+
+        return value;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+        T *value = nullptr;
+    };
+
+    // Padding instead of alignas, the queue is heap allocated and C++11 new doesn't honour extended alignment.
+    std::atomic<size_t> m_head{0};
+    char m_pad[64 - sizeof(std::atomic<size_t>)]{};
+    size_t m_tail = 0;
+    Cell m_cells[N];
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MPSCQUEUE_H */
@@ -18,6 +18,7 @@
 
 #include "core/Controller.h"
 #include "backend/cpu/Cpu.h"
+#include "base/kernel/Startup.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
@@ -30,6 +31,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_DMI
+#   include "hw/dmi/DmiReader.h"
+#endif
+
+
 #include <cassert>
 
 
@@ -41,20 +47,56 @@ xmrig::Controller::Controller(Process *process) :
 
 xmrig::Controller::~Controller()
 {
+#   ifdef XMRIG_FEATURE_DMI
+    if (m_dmiThread.joinable()) {
+        m_dmiThread.join();
+    }
+#   endif
+
+    if (m_memoryThread.joinable()) {
+        m_memoryThread.join();
+    }
+
     VirtualMemory::destroy();
 }
 
 
 int xmrig::Controller::init()
 {
-    Base::init();
+    // DMI and the memory pool don't depend on anything else, both are read and reserved while the rest of
+    // initialization, the summary and the API start run on this thread.
+#   ifdef XMRIG_FEATURE_DMI
+    if (config()->isDMI()) {
+        m_dmi       = std::make_shared<DmiReader>();
+        m_dmiThread = std::thread([this] {
+            Startup::begin("dmi");
+            m_dmiValid = m_dmi->read();
+            Startup::end("dmi");
+        });
+    }
+#   endif
+
+    // Cpu::info() is created lazily and is not thread safe, VirtualMemory::initPool() uses it from the memory thread
+    Cpu::info();
+
+    const size_t poolSize     = config()->cpu().memPoolSize();
+    const size_t hugePageSize = config()->cpu().hugePageSize();
 
-    VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().hugePageSize());
+    // Huge page size and availability are read by the summary, only the pool is reserved in the background
+    VirtualMemory::osInit(hugePageSize);
+
+    m_memoryThread = std::thread([poolSize, hugePageSize] {
+        Startup::begin("memory-pool");
+        VirtualMemory::initPool(poolSize, hugePageSize);
+        Startup::end("memory-pool");
+    });
+
+    Base::init();
 
     m_network = std::make_shared<Network>(this);
 
 #   ifdef XMRIG_FEATURE_API
-    m_hwApi = std::make_shared<HwApi>();
+    m_hwApi = std::make_shared<HwApi>(this);
     api()->addListener(m_hwApi.get());
 #   endif
 
@@ -66,8 +108,13 @@ void xmrig::Controller::start()
 {
     Base::start();
 
+    if (m_memoryThread.joinable()) {
+        m_memoryThread.join();
+    }
+
     m_miner = std::make_shared<Miner>(this);
 
+    Startup::mark("connect");
     network()->connect();
 }
 
@@ -104,3 +151,15 @@ void xmrig::Controller::execCommand(char command) const
     miner()->execCommand(command);
     network()->execCommand(command);
 }
+
+
+#ifdef XMRIG_FEATURE_DMI
+const xmrig::DmiReader *xmrig::Controller::dmi()
+{
+    if (m_dmiThread.joinable()) {
+        m_dmiThread.join();
+    }
+
+    return m_dmiValid ? m_dmi.get() : nullptr;
+}
+#endif
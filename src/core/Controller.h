@@ -24,11 +24,13 @@
 
 
 #include <memory>
+#include <thread>
 
 
 namespace xmrig {
 
 
+class DmiReader;
 class HwApi;
 class Job;
 class Miner;
@@ -51,9 +53,20 @@ public:
     Network *network() const;
     void execCommand(char command) const;
 
+#   ifdef XMRIG_FEATURE_DMI
+    const DmiReader *dmi();
+#   endif
+
 private:
     std::shared_ptr<Miner> m_miner;
     std::shared_ptr<Network> m_network;
+    std::thread m_memoryThread;
+
+#   ifdef XMRIG_FEATURE_DMI
+    bool m_dmiValid = false;
+    std::shared_ptr<DmiReader> m_dmi;
+    std::thread m_dmiThread;
+#   endif
 
 #   ifdef XMRIG_FEATURE_API
     std::shared_ptr<HwApi> m_hwApi;
@@ -41,6 +41,7 @@
 
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
+#   include "base/api/ApiSnapshot.h"
 #   include "base/api/interfaces/IApiRequest.h"
 #endif
 
@@ -72,6 +73,11 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_KAWPOW
+#   include "crypto/kawpow/KPCache.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -166,6 +172,12 @@ public:
         }
 
         reply.AddMember("algorithms", algo, allocator);
+
+#       ifdef XMRIG_ALGO_KAWPOW
+        if (algorithm.family() == Algorithm::KAWPOW) {
+            reply.AddMember("kawpow", KPCache::toJSON(doc), allocator);
+        }
+#       endif
     }
 
 
@@ -219,6 +231,49 @@ public:
     }
 
 
+    void getSnapshot(ApiSnapshot &snapshot) const
+    {
+        double t[3] = { 0.0 };
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (hr) {
+                t[0] += hr->calc(Hashrate::ShortInterval);
+                t[1] += hr->calc(Hashrate::MediumInterval);
+                t[2] += hr->calc(Hashrate::LargeInterval);
+            }
+        }
+
+        snapshot.beginSection(ApiSnapshot::SECTION_HASHRATE);
+        snapshot.putHashrate(t[0]);
+        snapshot.putHashrate(t[1]);
+        snapshot.putHashrate(t[2]);
+        snapshot.putHashrate(maxHashrate[algorithm]);
+        snapshot.endSection();
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr     = backend->hashrate();
+            const uint32_t threads = hr ? static_cast<uint32_t>(hr->threads()) : 0;
+
+            snapshot.beginSection(ApiSnapshot::SECTION_BACKEND);
+            snapshot.put(backend->type().data(), 8);
+            snapshot.put(static_cast<uint32_t>(backend->isEnabled()));
+            snapshot.put(threads);
+            snapshot.putHashrate(hr ? hr->calc(Hashrate::ShortInterval) : 0.0);
+            snapshot.putHashrate(hr ? hr->calc(Hashrate::MediumInterval) : 0.0);
+            snapshot.putHashrate(hr ? hr->calc(Hashrate::LargeInterval) : 0.0);
+
+            for (uint32_t i = 0; i < threads; ++i) {
+                snapshot.putHashrate(hr->calc(i, Hashrate::ShortInterval));
+                snapshot.putHashrate(hr->calc(i, Hashrate::MediumInterval));
+                snapshot.putHashrate(hr->calc(i, Hashrate::LargeInterval));
+            }
+
+            snapshot.endSection();
+        }
+    }
+
+
     void getBackends(rapidjson::Value &reply, rapidjson::Document &doc) const
     {
         using namespace rapidjson;
@@ -697,6 +752,11 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             d_ptr->getBackends(request.reply(), request.doc());
         }
+        else if (request.type() == IApiRequest::REQ_SNAPSHOT) {
+            request.accept();
+
+            d_ptr->getSnapshot(request.snapshot());
+        }
     }
     else if (request.type() == IApiRequest::REQ_JSON_RPC) {
         if (request.rpcMethod() == "pause") {
@@ -64,7 +64,7 @@ const char *Config::kOcl                = "opencl";
 const char *Config::kCuda               = "cuda";
 #endif
 
-#if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
 const char *Config::kHealthPrintTime    = "health-print-time";
 #endif
 
@@ -92,7 +92,7 @@ public:
     CudaConfig cuda;
 #   endif
 
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     uint32_t healthPrintTime = 60U;
 #   endif
 
@@ -168,7 +168,7 @@ const xmrig::RxConfig &xmrig::Config::rx() const
 #endif
 
 
-#if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
 uint32_t xmrig::Config::healthPrintTime() const
 {
     return d_ptr->healthPrintTime;
@@ -235,7 +235,7 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     }
 #   endif
 
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     d_ptr->healthPrintTime = reader.getUint(kHealthPrintTime, d_ptr->healthPrintTime);
 #   endif
 
@@ -281,11 +281,12 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(kLogFile),                  m_logFile.toJSON(), allocator);
+    doc.AddMember(StringRef(kLogJson),                  m_logJson.toJSON(), allocator);
 
     m_pools.toJSON(doc, doc);
 
     doc.AddMember(StringRef(kPrintTime),                printTime(), allocator);
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     doc.AddMember(StringRef(kHealthPrintTime),          healthPrintTime(), allocator);
 #   endif
 
@@ -55,7 +55,7 @@ public:
     static const char *kCuda;
 #   endif
 
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     static const char *kHealthPrintTime;
 #   endif
 
@@ -84,7 +84,7 @@ public:
     const RxConfig &rx() const;
 #   endif
 
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     uint32_t healthPrintTime() const;
 #   else
     uint32_t healthPrintTime() const        { return 0; }
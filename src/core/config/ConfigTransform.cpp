@@ -69,6 +69,10 @@ static inline uint64_t intensity(uint64_t av)
     case CnHash::AV_PENTA:
         return 5;
 
+    case CnHash::AV_OCTA_SOFT:
+    case CnHash::AV_OCTA:
+        return 8;
+
     default:
         break;
     }
@@ -79,7 +83,7 @@ static inline uint64_t intensity(uint64_t av)
 
 static inline bool isHwAes(uint64_t av)
 {
-    return av == CnHash::AV_SINGLE || av == CnHash::AV_DOUBLE || (av > CnHash::AV_DOUBLE_SOFT && av < CnHash::AV_TRIPLE_SOFT);
+    return av == CnHash::AV_SINGLE || av == CnHash::AV_DOUBLE || (av > CnHash::AV_DOUBLE_SOFT && av < CnHash::AV_TRIPLE_SOFT) || av == CnHash::AV_OCTA;
 }
 
 
@@ -147,6 +151,21 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::YieldKey: /* --cpu-no-yield */
         return set(doc, CpuConfig::kField, CpuConfig::kYield, false);
 
+    case IConfig::CPUWatchdogKey: /* --cpu-watchdog */
+        return set(doc, CpuConfig::kField, CpuConfig::kWatchdog, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
+    case IConfig::CPUWatchdogRestartKey: /* --cpu-watchdog-restart */
+        return set(doc, CpuConfig::kField, CpuConfig::kWatchdogRestart, true);
+
+    case IConfig::CPUSelfTestPerThreadKey: /* --cpu-self-test-per-thread */
+        return set(doc, CpuConfig::kField, CpuConfig::kSelfTestPerThread, true);
+
+    case IConfig::CPUEfficiencyKey: /* --cpu-efficiency */
+        return set(doc, CpuConfig::kField, CpuConfig::kEfficiency, true);
+
+    case IConfig::CPUEfficiencyPowerLimitKey: /* --cpu-efficiency-power-limit */
+        return set(doc, CpuConfig::kField, CpuConfig::kEfficiencyPowerLimit, true);
+
     case IConfig::PauseOnBatteryKey: /* --pause-on-battery */
         return set(doc, Config::kPauseOnBattery, true);
 
@@ -169,6 +188,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
 
     case IConfig::AstroBWTAVX2Key: /* --astrobwt-avx2 */
         return set(doc, CpuConfig::kField, CpuConfig::kAstroBWTAVX2, true);
+
+    case IConfig::AstroBWTSortKey: /* --astrobwt-sort */
+        return set(doc, CpuConfig::kField, CpuConfig::kAstroBWTSort, arg);
 #   endif
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -199,6 +221,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::RandomXCacheQoSKey: /* --cache-qos */
         return set(doc, RxConfig::kField, RxConfig::kCacheQoS, true);
 
+    case IConfig::RandomXMsrExploreKey: /* --randomx-msr-explore */
+        return set(doc, RxConfig::kField, RxConfig::kMsrExplore, true);
+
     case IConfig::HugePagesJitKey: /* --huge-pages-jit */
         return set(doc, CpuConfig::kField, CpuConfig::kHugePagesJit, true);
 #   endif
@@ -249,7 +274,7 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
         return set(doc, Config::kCuda, "nvml", false);
 #   endif
 
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     case IConfig::HealthPrintTimeKey: /* --health-print-time */
         return set(doc, Config::kHealthPrintTime, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
 #   endif
@@ -52,6 +52,9 @@ R"===(
         "rdmsr": true,
         "wrmsr": true,
         "cache_qos": false,
+        "cache_qos_l3": null,
+        "cache_qos_mb": 100,
+        "msr-explore": false,
         "numa": true,
         "scratchpad_prefetch_mode": 1
     },
@@ -63,11 +66,17 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "watchdog": 70,
+        "watchdog-restart": false,
+        "efficiency": false,
+        "efficiency-power-limit": false,
+        "self-test-per-thread": false,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
         "astrobwt-max-size": 550,
         "astrobwt-avx2": false,
+        "astrobwt-sort": null,
         "cn/0": false,
         "cn-lite/0": false
     },
@@ -90,6 +99,7 @@ R"===(
     "donate-level": 1,
     "donate-over-proxy": 1,
     "log-file": null,
+    "log-json": null,
     "pools": [
         {
             "algo": null,
@@ -64,6 +64,7 @@ static const option options[] = {
     { "dry-run",               0, nullptr, IConfig::DryRunKey             },
     { "keepalive",             0, nullptr, IConfig::KeepAliveKey          },
     { "log-file",              1, nullptr, IConfig::LogFileKey            },
+    { "log-json",              1, nullptr, IConfig::LogJsonKey            },
     { "nicehash",              0, nullptr, IConfig::NicehashKey           },
     { "no-color",              0, nullptr, IConfig::ColorKey              },
     { "no-huge-pages",         0, nullptr, IConfig::HugePagesKey          },
@@ -88,6 +89,11 @@ static const option options[] = {
     { "cpu-max-threads-hint",  1, nullptr, IConfig::CPUMaxThreadsKey      },
     { "cpu-memory-pool",       1, nullptr, IConfig::MemoryPoolKey         },
     { "cpu-no-yield",          0, nullptr, IConfig::YieldKey              },
+    { "cpu-watchdog",          1, nullptr, IConfig::CPUWatchdogKey        },
+    { "cpu-watchdog-restart",  0, nullptr, IConfig::CPUWatchdogRestartKey },
+    { "cpu-self-test-per-thread", 0, nullptr, IConfig::CPUSelfTestPerThreadKey },
+    { "cpu-efficiency",        0, nullptr, IConfig::CPUEfficiencyKey      },
+    { "cpu-efficiency-power-limit", 0, nullptr, IConfig::CPUEfficiencyPowerLimitKey },
     { "no-yield",              0, nullptr, IConfig::YieldKey              },
     { "cpu-argon2-impl",       1, nullptr, IConfig::Argon2ImplKey         },
     { "argon2-impl",           1, nullptr, IConfig::Argon2ImplKey         },
@@ -139,10 +145,12 @@ static const option options[] = {
     { "no-rdmsr",              0, nullptr, IConfig::RandomXRdmsrKey       },
     { "randomx-cache-qos",     0, nullptr, IConfig::RandomXCacheQoSKey    },
     { "cache-qos",             0, nullptr, IConfig::RandomXCacheQoSKey    },
+    { "randomx-msr-explore",   0, nullptr, IConfig::RandomXMsrExploreKey  },
 #   endif
     #ifdef XMRIG_ALGO_ASTROBWT
     { "astrobwt-max-size",     1, nullptr, IConfig::AstroBWTMaxSizeKey    },
     { "astrobwt-avx2",         0, nullptr, IConfig::AstroBWTAVX2Key       },
+    { "astrobwt-sort",         1, nullptr, IConfig::AstroBWTSortKey       },
     #endif
 #   ifdef XMRIG_FEATURE_OPENCL
     { "opencl",                0, nullptr, IConfig::OclKey                },
@@ -161,7 +169,7 @@ static const option options[] = {
 #   ifdef XMRIG_FEATURE_NVML
     { "no-nvml",               0, nullptr, IConfig::NvmlKey               },
 #   endif
-#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     { "health-print-time",     1, nullptr, IConfig::HealthPrintTimeKey    },
 #   endif
 #   ifdef XMRIG_FEATURE_DMI
@@ -85,6 +85,13 @@ static inline const std::string &usage()
     u += "      --cpu-max-threads-hint=N  maximum CPU threads count (in percentage) hint for autoconfig\n";
     u += "      --cpu-memory-pool=N       number of 2 MB pages for persistent memory pool, -1 (auto), 0 (disable)\n";
     u += "      --cpu-no-yield            prefer maximum hashrate rather than system response/stability\n";
+    u += "      --cpu-watchdog=N          report threads slower than N% of their baseline and of the median thread, 0 (disable)\n";
+    u += "      --cpu-watchdog-restart    recreate threads which stay degraded, with new scratchpads\n";
+    u += "      --cpu-self-test-per-thread  run the self-test on every thread instead of once per hash implementation\n";
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    u += "      --cpu-efficiency          search for the thread count and intensity with the best hashes per joule\n";
+    u += "      --cpu-efficiency-power-limit  also step down the Intel package power limit (PL1), requires MSR access\n";
+#   endif
     u += "      --no-huge-pages           disable huge pages support\n";
 #   ifdef XMRIG_OS_LINUX
     u += "      --hugepage-size=N         custom hugepage size in kB\n";
@@ -106,11 +113,15 @@ static inline const std::string &usage()
     u += "      --randomx-wrmsr=N         write custom value(s) to MSR registers or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
     u += "      --randomx-cache-qos       enable Cache QoS\n";
+#   ifdef XMRIG_FEATURE_MSR
+    u += "      --randomx-msr-explore     benchmark whitelisted prefetcher MSR bits while mining and report the best preset\n";
+#   endif
 #   endif
 
 #   ifdef XMRIG_ALGO_ASTROBWT
     u += "      --astrobwt-max-size=N     skip hashes with large stage 2 size, default: 550, min: 400, max: 1200\n";
-    u += "      --astrobwt-avx2           enable AVX2 optimizations for AstroBWT algorithm";
+    u += "      --astrobwt-avx2           enable AVX2 optimizations for AstroBWT algorithm\n";
+    u += "      --astrobwt-sort=SORT      AstroBWT suffix sort: auto, radix, sais";
 #   endif
 
 #   ifdef XMRIG_FEATURE_OPENCL
@@ -163,8 +174,9 @@ static inline const std::string &usage()
 #   endif
 
     u += "  -l, --log-file=FILE           log all output to a file\n";
+    u += "      --log-json=FILE           write share, job, dataset and error events as JSON lines to a rotating file\n";
     u += "      --print-time=N            print hashrate report every N seconds\n";
-#   if defined(XMRIG_FEATURE_NVML) || defined(XMRIG_FEATURE_ADL)
+#   if defined(XMRIG_FEATURE_NVML) || defined(XMRIG_FEATURE_ADL) || defined(XMRIG_FEATURE_TELEMETRY)
     u += "      --health-print-time=N     print health report every N seconds\n";
 #   endif
     u += "      --no-color                disable colored output\n";
@@ -181,6 +193,11 @@ static inline const std::string &usage()
 #   ifdef XMRIG_FEATURE_HWLOC
     u += "      --export-topology         export hwloc topology to a XML file and exit\n";
 #   endif
+    u += "      --print-plan              print CPU thread placement plan (for -a or every algorithm family) and exit\n";
+
+#   ifdef XMRIG_FEATURE_TELEMETRY
+    u += "      --health                  print CPU frequency, C0 residency, temperature and power and exit\n";
+#   endif
 
 #   ifdef XMRIG_OS_WIN
     u += "      --title                   set custom console window title\n";
@@ -192,6 +209,12 @@ static inline const std::string &usage()
 #   ifdef XMRIG_FEATURE_BENCHMARK
     u += "      --stress                  run continuous stress test to check system stability\n";
     u += "      --bench=N                 run benchmark, N can be between 1M and 10M\n";
+    u += "      --core-health             check every logical CPU against known RandomX and CryptoNight results and exit\n";
+    u += "      --core-health-rounds=N    number of core health rounds (default: 3)\n";
+    u += "      --bench-suite             run offline benchmark of every algorithm, thread profile and AV setting and exit\n";
+    u += "      --bench-suite-repeats=N   number of runs of every benchmark suite entry (default: 3)\n";
+    u += "      --bench-suite-time=N      duration of every benchmark suite run in seconds (default: 10)\n";
+    u += "      --bench-suite-out=FILE    benchmark suite JSON report file (default: bench-suite.json)\n";
 #   ifdef XMRIG_FEATURE_HTTP
     u += "      --submit                  perform an online benchmark and submit result for sharing\n";
     u += "      --verify=ID               verify submitted benchmark by ID\n";
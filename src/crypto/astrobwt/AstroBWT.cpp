@@ -24,10 +24,15 @@
 #include "backend/cpu/Cpu.h"
 #include "base/crypto/sha3.h"
 #include "base/tools/bswap_64.h"
+#include "base/tools/Chrono.h"
+#include "crypto/astrobwt/sais.h"
 #include "crypto/cn/CryptoNight.h"
+#include "crypto/common/portable/mm_malloc.h"
 
 
+#include <atomic>
 #include <limits>
+#include <mutex>
 
 
 constexpr int STAGE1_SIZE = 147253;
@@ -36,8 +41,22 @@ constexpr int ALLOCATION_SIZE = (STAGE1_SIZE + 1048576) + (128 - (STAGE1_SIZE &
 constexpr int COUNTING_SORT_BITS = 10;
 constexpr int COUNTING_SORT_SIZE = 1 << COUNTING_SORT_BITS;
 
+// Must match Algorithm::l3() for ASTROBWT_DERO
+constexpr size_t SCRATCHPAD_SIZE = 0x100000 * 20;
+
 static bool astrobwtInitialized = false;
 
+// Selection state is guarded by sortMutex, sortAlgo is read by the hashing threads
+static std::mutex sortMutex;
+static bool sortSelected = false;
+static bool sortAVX2 = false;
+static int sortMaxSize = 0;
+static xmrig::String sortHint;
+static std::atomic<xmrig::astrobwt::SortAlgo> sortAlgo(xmrig::astrobwt::SORT_RADIX);
+static double sortTime[xmrig::astrobwt::SORT_MAX] = {};
+
+static const char* sortNames[xmrig::astrobwt::SORT_MAX] = { "radix", "sais" };
+
 #ifdef ASTROBWT_AVX2
 static bool hasAVX2 = false;
 
@@ -348,7 +367,7 @@ void sort_indices2(uint32_t N, const uint8_t* v, uint64_t* indices, uint64_t* tm
 	}
 }
 
-bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size, void* scratchpad, uint8_t* output_hash, int stage2_max_size, bool avx2)
+static bool astrobwt_dero(const void* input_data, uint32_t input_size, void* scratchpad, uint8_t* output_hash, int stage2_max_size, bool avx2, xmrig::astrobwt::SortAlgo sort)
 {
 	alignas(8) uint8_t key[32];
 	uint8_t* scratchpad_ptr = (uint8_t*)(scratchpad) + 64;
@@ -359,6 +378,10 @@ bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size,
 	uint8_t* stage1_result = (uint8_t*)(tmp_indices);
 	uint8_t* stage2_result = (uint8_t*)(tmp_indices);
 
+	// SA-IS uses everything after the index array as its workspace
+	uint8_t* workspace = (uint8_t*)(tmp_indices);
+	const size_t workspace_size = (uint8_t*)(scratchpad) + SCRATCHPAD_SIZE - workspace;
+
 #ifdef ASTROBWT_AVX2
 	if (hasAVX2 && avx2) {
 		SHA3_256_AVX2_ASM(input_data, input_size, key);
@@ -371,7 +394,9 @@ bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size,
 		Salsa20_XORKeyStream(key, stage1_output, STAGE1_SIZE);
 	}
 
-	sort_indices(STAGE1_SIZE + 1, stage1_output, indices, tmp_indices);
+	if ((sort != xmrig::astrobwt::SORT_SAIS) || !xmrig::astrobwt::sais(STAGE1_SIZE + 1, stage1_output, indices, workspace, workspace_size)) {
+		sort_indices(STAGE1_SIZE + 1, stage1_output, indices, tmp_indices);
+	}
 
 	{
 		const uint8_t* tmp = stage1_output - 1;
@@ -402,7 +427,9 @@ bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size,
 		Salsa20_XORKeyStream(key, stage2_output, stage2_size);
 	}
 
-	sort_indices2(stage2_size + 1, stage2_output, indices, tmp_indices);
+	if ((sort != xmrig::astrobwt::SORT_SAIS) || !xmrig::astrobwt::sais(stage2_size + 1, stage2_output, indices, workspace, workspace_size)) {
+		sort_indices2(stage2_size + 1, stage2_output, indices, tmp_indices);
+	}
 
 	{
 		const uint8_t* tmp = stage2_output - 1;
@@ -433,6 +460,81 @@ bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size,
 }
 
 
+bool xmrig::astrobwt::astrobwt_dero(const void* input_data, uint32_t input_size, void* scratchpad, uint8_t* output_hash, int stage2_max_size, bool avx2)
+{
+	return ::astrobwt_dero(input_data, input_size, scratchpad, output_hash, stage2_max_size, avx2, sortAlgo);
+}
+
+
+bool xmrig::astrobwt::select_sort(const String& hint, int stage2_max_size, bool avx2)
+{
+	std::lock_guard<std::mutex> lock(sortMutex);
+
+	// Selected once per configuration, a changed hint or benchmark parameter repeats the selection
+	if (sortSelected && (sortHint == hint) && (sortMaxSize == stage2_max_size) && (sortAVX2 == avx2)) {
+		return false;
+	}
+
+	sortSelected = true;
+	sortHint     = hint;
+	sortMaxSize  = stage2_max_size;
+	sortAVX2     = avx2;
+
+	for (int i = 0; i < SORT_MAX; ++i) {
+		if (hint == sortNames[i]) {
+			sortAlgo = static_cast<SortAlgo>(i);
+			std::fill(sortTime, sortTime + SORT_MAX, 0.0);
+
+			return true;
+		}
+	}
+
+	// Micro-benchmark: hash the same inputs with both sorters, stage 2 sizes follow the real distribution
+	// and hashes above stage2_max_size are rejected the same way the miner does it.
+	// The radix sorter compares only the first 13 bytes of every suffix and keeps equal prefixes in position order,
+	// SA-IS sorts complete suffixes, so the two agree only if no prefixes are equal. SA-IS is used only when
+	// the benchmark hashes match.
+	constexpr uint32_t BENCH_HASHES = 4;
+
+	uint8_t* scratchpad = static_cast<uint8_t*>(_mm_malloc(SCRATCHPAD_SIZE, 4096));
+	uint8_t blob[76] = {};
+	uint8_t hash[SORT_MAX][BENCH_HASHES][32] = {};
+
+	for (int i = 0; i < SORT_MAX; ++i) {
+		const SortAlgo algo = static_cast<SortAlgo>(i);
+
+		// Warm-up, the first run pays for page faults
+		::astrobwt_dero(blob, sizeof(blob), scratchpad, hash[i][0], stage2_max_size, avx2, algo);
+
+		const double start = Chrono::highResolutionMSecs();
+		for (uint32_t nonce = 0; nonce < BENCH_HASHES; ++nonce) {
+			memcpy(blob + 39, &nonce, sizeof(nonce));
+			::astrobwt_dero(blob, sizeof(blob), scratchpad, hash[i][nonce], stage2_max_size, avx2, algo);
+		}
+
+		sortTime[i] = (Chrono::highResolutionMSecs() - start) / BENCH_HASHES;
+	}
+
+	_mm_free(scratchpad);
+
+	sortAlgo = ((sortTime[SORT_SAIS] < sortTime[SORT_RADIX]) && (memcmp(hash[SORT_SAIS], hash[SORT_RADIX], sizeof(hash[0])) == 0)) ? SORT_SAIS : SORT_RADIX;
+
+	return true;
+}
+
+
+const char* xmrig::astrobwt::sort_name()
+{
+	return sortNames[sortAlgo];
+}
+
+
+double xmrig::astrobwt::sort_time(SortAlgo algo)
+{
+	return sortTime[algo];
+}
+
+
 void xmrig::astrobwt::init()
 {
 	if (!astrobwtInitialized) {
@@ -21,6 +21,7 @@
  */
 
 #include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
 
 
 struct cryptonight_ctx;
@@ -31,7 +32,16 @@ namespace xmrig {
 
 namespace astrobwt {
 
+enum SortAlgo {
+	SORT_RADIX,
+	SORT_SAIS,
+	SORT_MAX
+};
+
 bool astrobwt_dero(const void* input_data, uint32_t input_size, void* scratchpad, uint8_t* output_hash, int stage2_max_size, bool avx2);
+bool select_sort(const String& hint, int stage2_max_size, bool avx2);
+const char* sort_name();
+double sort_time(SortAlgo algo);
 void init();
 
 template<Algorithm::Id ALGO>
@@ -0,0 +1,287 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/astrobwt/sais.h"
+
+
+#include <cstring>
+
+
+#if defined(__GNUC__)
+#	define SAIS_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_M_X64) || defined(_M_IX86)
+#	include <xmmintrin.h>
+#	define SAIS_PREFETCH(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#else
+#	define SAIS_PREFETCH(p)
+#endif
+
+
+// Based on "Two Efficient Algorithms for Linear Time Suffix Array Construction" by Ge Nong, Sen Zhang and Wai Hong Chan.
+// Every level works on 32-bit symbols with a unique smallest sentinel at the end, so the byte input is widened once
+// (v[i] + 1, sentinel 0) and the sentinel naturally becomes the empty suffix that AstroBWT sorts first.
+
+
+namespace {
+
+
+// Distance (in SA entries) of the text prefetch in the induce passes, the scan over SA is sequential but s[SA[i] - 1] is not.
+constexpr int PREFETCH_DIST = 32;
+
+
+class Workspace
+{
+public:
+	inline Workspace(uint8_t* p, size_t size) : m_p(p), m_end(p + size) {}
+
+	template<typename T>
+	inline T* alloc(size_t count)
+	{
+		uint8_t* p = m_p + ((64 - (reinterpret_cast<uintptr_t>(m_p) & 63)) & 63);
+		if ((p > m_end) || (count * sizeof(T) > static_cast<size_t>(m_end - p))) {
+			return nullptr;
+		}
+
+		m_p = p + count * sizeof(T);
+		return reinterpret_cast<T*>(p);
+	}
+
+	inline uint8_t* mark() const	{ return m_p; }
+	inline void reset(uint8_t* p)	{ m_p = p; }
+
+private:
+	uint8_t* m_p;
+	uint8_t* m_end;
+};
+
+
+static inline bool tget(const uint8_t* t, int32_t i)			{ return (t[i >> 3] >> (i & 7)) & 1; }
+static inline void tset(uint8_t* t, int32_t i, bool b)		{ if (b) t[i >> 3] |= (1 << (i & 7)); else t[i >> 3] &= ~(1 << (i & 7)); }
+static inline bool is_lms(const uint8_t* t, int32_t i)		{ return (i > 0) && tget(t, i) && !tget(t, i - 1); }
+
+
+static void get_buckets(const int32_t* s, int32_t* bkt, int32_t n, int32_t K, bool end)
+{
+	memset(bkt, 0, sizeof(int32_t) * K);
+
+	for (int32_t i = 0; i < n; ++i) {
+		++bkt[s[i]];
+	}
+
+	int32_t sum = 0;
+	for (int32_t i = 0; i < K; ++i) {
+		sum += bkt[i];
+		bkt[i] = end ? sum : (sum - bkt[i]);
+	}
+}
+
+
+static void induce_l(const uint8_t* t, int32_t* SA, const int32_t* s, int32_t* bkt, int32_t n, int32_t K)
+{
+	get_buckets(s, bkt, n, K, false);
+
+	for (int32_t i = 0; i < n; ++i) {
+		if (i + PREFETCH_DIST < n) {
+			const int32_t k = SA[i + PREFETCH_DIST];
+			if (k > 0) {
+				SAIS_PREFETCH(s + k - 1);
+			}
+		}
+
+		const int32_t j = SA[i] - 1;
+		if ((j >= 0) && !tget(t, j)) {
+			SA[bkt[s[j]]++] = j;
+		}
+	}
+}
+
+
+static void induce_s(const uint8_t* t, int32_t* SA, const int32_t* s, int32_t* bkt, int32_t n, int32_t K)
+{
+	get_buckets(s, bkt, n, K, true);
+
+	for (int32_t i = n - 1; i >= 0; --i) {
+		if (i >= PREFETCH_DIST) {
+			const int32_t k = SA[i - PREFETCH_DIST];
+			if (k > 0) {
+				SAIS_PREFETCH(s + k - 1);
+			}
+		}
+
+		const int32_t j = SA[i] - 1;
+		if ((j >= 0) && tget(t, j)) {
+			SA[--bkt[s[j]]] = j;
+		}
+	}
+}
+
+
+static bool sa_is(const int32_t* s, int32_t* SA, int32_t n, int32_t K, Workspace& ws)
+{
+	uint8_t* mark = ws.mark();
+
+	uint8_t* t = ws.alloc<uint8_t>(n / 8 + 1);
+	int32_t* bkt = ws.alloc<int32_t>(K);
+	if (!t || !bkt) {
+		return false;
+	}
+
+	// Classify suffixes: S-type = 1, L-type = 0
+	tset(t, n - 1, true);
+	if (n > 1) {
+		tset(t, n - 2, false);
+	}
+	for (int32_t i = n - 3; i >= 0; --i) {
+		tset(t, i, (s[i] < s[i + 1]) || ((s[i] == s[i + 1]) && tget(t, i + 1)));
+	}
+
+	// Stage 1: sort LMS substrings
+	get_buckets(s, bkt, n, K, true);
+	for (int32_t i = 0; i < n; ++i) {
+		SA[i] = -1;
+	}
+	for (int32_t i = 1; i < n; ++i) {
+		if (is_lms(t, i)) {
+			SA[--bkt[s[i]]] = i;
+		}
+	}
+
+	induce_l(t, SA, s, bkt, n, K);
+	induce_s(t, SA, s, bkt, n, K);
+
+	int32_t n1 = 0;
+	for (int32_t i = 0; i < n; ++i) {
+		if (is_lms(t, SA[i])) {
+			SA[n1++] = SA[i];
+		}
+	}
+
+	for (int32_t i = n1; i < n; ++i) {
+		SA[i] = -1;
+	}
+
+	// Name LMS substrings
+	int32_t name = 0;
+	int32_t prev = -1;
+	for (int32_t i = 0; i < n1; ++i) {
+		const int32_t pos = SA[i];
+		bool diff = false;
+
+		for (int32_t d = 0; d < n; ++d) {
+			if ((prev == -1) || (s[pos + d] != s[prev + d]) || (tget(t, pos + d) != tget(t, prev + d))) {
+				diff = true;
+				break;
+			}
+
+			if ((d > 0) && (is_lms(t, pos + d) || is_lms(t, prev + d))) {
+				break;
+			}
+		}
+
+		if (diff) {
+			++name;
+			prev = pos;
+		}
+
+		SA[n1 + (pos >> 1)] = name - 1;
+	}
+
+	for (int32_t i = n - 1, j = n - 1; i >= n1; --i) {
+		if (SA[i] >= 0) {
+			SA[j--] = SA[i];
+		}
+	}
+
+	// Stage 2: sort the reduced problem, recurse only if names are not unique yet
+	int32_t* s1 = SA + n - n1;
+	int32_t* SA1 = SA;
+
+	if (name < n1) {
+		if (!sa_is(s1, SA1, n1, name, ws)) {
+			return false;
+		}
+	}
+	else {
+		for (int32_t i = 0; i < n1; ++i) {
+			SA1[s1[i]] = i;
+		}
+	}
+
+	// Stage 3: induce the final order from the sorted LMS suffixes
+	get_buckets(s, bkt, n, K, true);
+	for (int32_t i = 1, j = 0; i < n; ++i) {
+		if (is_lms(t, i)) {
+			s1[j++] = i;
+		}
+	}
+
+	for (int32_t i = 0; i < n1; ++i) {
+		SA1[i] = s1[SA1[i]];
+	}
+
+	for (int32_t i = n1; i < n; ++i) {
+		SA[i] = -1;
+	}
+
+	for (int32_t i = n1 - 1; i >= 0; --i) {
+		const int32_t j = SA[i];
+		SA[i] = -1;
+		SA[--bkt[s[j]]] = j;
+	}
+
+	induce_l(t, SA, s, bkt, n, K);
+	induce_s(t, SA, s, bkt, n, K);
+
+	ws.reset(mark);
+	return true;
+}
+
+
+} // namespace
+
+
+bool xmrig::astrobwt::sais(uint32_t N, const uint8_t* v, uint64_t* indices, uint8_t* workspace, size_t workspace_size)
+{
+	Workspace ws(workspace, workspace_size);
+
+	const int32_t n = static_cast<int32_t>(N);
+	int32_t* s = ws.alloc<int32_t>(N);
+	if (!s) {
+		return false;
+	}
+
+	for (int32_t i = 0; i < n - 1; ++i) {
+		s[i] = v[i] + 1;
+	}
+	s[n - 1] = 0;
+
+	// 32-bit suffix array is built in the first half of the output buffer and widened in place
+	int32_t* SA = reinterpret_cast<int32_t*>(indices);
+	if (!sa_is(s, SA, n, 257, ws)) {
+		return false;
+	}
+
+	const uint8_t* src = reinterpret_cast<const uint8_t*>(indices);
+	for (int32_t i = n - 1; i >= 0; --i) {
+		int32_t k;
+		memcpy(&k, src + i * sizeof(int32_t), sizeof(k));
+		indices[i] = static_cast<uint64_t>(k);
+	}
+
+	return true;
+}
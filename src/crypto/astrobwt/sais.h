@@ -0,0 +1,43 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ASTROBWT_SAIS_H
+#define XMRIG_ASTROBWT_SAIS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+namespace astrobwt {
+
+
+// Linear time suffix array construction (SA-IS) for N - 1 bytes of v plus the empty suffix.
+// Output has the same layout as sort_indices(): N entries, the position is stored in the low 21 bits.
+// The order is the exact suffix order, it differs from sort_indices() if two suffixes share the first 13 bytes.
+// All temporary data lives in the caller provided workspace, returns false if it is too small.
+bool sais(uint32_t N, const uint8_t* v, uint64_t* indices, uint8_t* workspace, size_t workspace_size);
+
+
+}} // namespace xmrig::astrobwt
+
+
+#endif /* XMRIG_ASTROBWT_SAIS_H */
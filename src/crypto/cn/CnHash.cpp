@@ -52,11 +52,24 @@
         m_map[algo]->data[AV_QUAD_SOFT][Assembly::NONE]   = cryptonight_quad_hash<algo,   true>;     \
         m_map[algo]->data[AV_PENTA][Assembly::NONE]       = cryptonight_penta_hash<algo,  false>;    \
         m_map[algo]->data[AV_PENTA_SOFT][Assembly::NONE]  = cryptonight_penta_hash<algo,  true>;     \
+        ADD_FN_OCTA(algo);                                                                           \
     } while (0)
 
 
+// No 8-way implementation on ARM, CnHash::fn returns nullptr and intensity 8 fails the self-test
+#ifdef XMRIG_ARM
+#   define ADD_FN_OCTA(algo)
+#else
+#   define ADD_FN_OCTA(algo) do {                                                                    \
+        m_map[algo]->data[AV_OCTA][Assembly::NONE]        = cryptonight_octa_hash<algo,   false>;    \
+        m_map[algo]->data[AV_OCTA_SOFT][Assembly::NONE]   = cryptonight_octa_hash<algo,   true>;     \
+    } while (0)
+#endif
+
+
 bool cn_sse41_enabled = false;
 bool cn_vaes_enabled = false;
+bool cn_vaes512_enabled = false;
 
 
 #ifdef XMRIG_FEATURE_ASM
@@ -55,6 +55,8 @@ public:
         AV_TRIPLE_SOFT, // --av=8  Triple hash mode (Software AES)
         AV_QUAD_SOFT,   // --av=9  Quard hash mode  (Software AES)
         AV_PENTA_SOFT,  // --av=10 Penta hash mode  (Software AES)
+        AV_OCTA,        // --av=11 Octa hash mode
+        AV_OCTA_SOFT,   // --av=12 Octa hash mode   (Software AES)
         AV_MAX
     };
 
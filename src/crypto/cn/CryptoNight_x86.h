@@ -43,6 +43,11 @@
 #include "crypto/cn/soft_aes.h"
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_VAES
 #   include "crypto/cn/CryptoNight_x86_vaes.h"
 #endif
@@ -591,6 +596,18 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
 
 
+template<xmrig::Algorithm::Id ALGO>
+void cn_r_generate_code_soft_aes(uint64_t height, void *machine_code, xmrig::Assembly::Id)
+{
+    V4_Instruction code[256];
+    const int code_size = v4_random_math_init<ALGO>(code, height);
+
+    if (ALGO == xmrig::Algorithm::CN_R) {
+        v4_soft_aes_compile_code(code, code_size, machine_code, xmrig::Assembly::NONE);
+    }
+}
+
+
 alignas(64) static const uint32_t tweak1_table[256] = { 268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456 };
 
 
@@ -691,13 +708,7 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
 #   ifdef XMRIG_FEATURE_ASM
     if (SOFT_AES && props.isR()) {
         if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
-
+            ctx[0]->generated_code      = CnRCache::acquire(ALGO, height, CnRCache::SOFT_AES, Assembly::NONE, cn_r_generate_code_soft_aes<ALGO>, ctx[0]->generated_code);
             ctx[0]->generated_code_data = { ALGO, height };
         }
 
@@ -937,6 +948,24 @@ void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* m
 }
 
 
+template<xmrig::Algorithm::Id ALGO>
+void cn_r_generate_code(uint64_t height, void *machine_code, xmrig::Assembly::Id ASM)
+{
+    V4_Instruction code[256];
+    const int code_size = v4_random_math_init<ALGO>(code, height);
+    cn_r_compile_code<ALGO>(code, code_size, machine_code, ASM);
+}
+
+
+template<xmrig::Algorithm::Id ALGO>
+void cn_r_generate_code_double(uint64_t height, void *machine_code, xmrig::Assembly::Id ASM)
+{
+    V4_Instruction code[256];
+    const int code_size = v4_random_math_init<ALGO>(code, height);
+    cn_r_compile_code_double<ALGO>(code, code_size, machine_code, ASM);
+}
+
+
 namespace xmrig {
 
 
@@ -946,10 +975,7 @@ inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRCache::acquire(ALGO, height, CnRCache::SINGLE, ASM, cn_r_generate_code<ALGO>, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1052,10 +1078,7 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRCache::acquire(ALGO, height, CnRCache::DOUBLE, ASM, cn_r_generate_code_double<ALGO>, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1548,6 +1571,12 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
         ctx[3]->first_half = true;
     }
 
+#   ifdef XMRIG_VAES512
+    if (!props.isHeavy() && cn_vaes512_enabled) {
+        cn_explode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+    }
+    else
+#   endif
 #   ifdef XMRIG_VAES
     if (!props.isHeavy() && cn_vaes_enabled) {
         cn_explode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
@@ -1576,6 +1605,12 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
     if (ALGO == Algorithm::CN_GR_4) cn_gr4_quad_mainloop_asm(ctx);
     if (ALGO == Algorithm::CN_GR_5) cn_gr5_quad_mainloop_asm(ctx);
 
+#   ifdef XMRIG_VAES512
+    if (!props.isHeavy() && cn_vaes512_enabled) {
+        cn_implode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+    }
+    else
+#   endif
 #   ifdef XMRIG_VAES
     if (!props.isHeavy() && cn_vaes_enabled) {
         cn_implode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
@@ -1841,6 +1876,12 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
         }
     }
 
+#   ifdef XMRIG_VAES512
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes512_enabled) {
+        cn_explode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+    }
+    else
+#   endif
 #   ifdef XMRIG_VAES
     if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
         cn_explode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
@@ -1904,6 +1945,12 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
         CN_STEP4(3, ax3, bx30, bx31, cx3, l3, mc3, ptr3, idx3);
     }
 
+#   ifdef XMRIG_VAES512
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes512_enabled) {
+        cn_implode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+    }
+    else
+#   endif
 #   ifdef XMRIG_VAES
     if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
         cn_implode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
@@ -2018,6 +2065,163 @@ inline void cryptonight_penta_hash(const uint8_t *__restrict__ input, size_t siz
 }
 
 
+template<Algorithm::Id ALGO, bool SOFT_AES>
+inline void cryptonight_octa_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t height)
+{
+    constexpr CnAlgo<ALGO> props;
+    constexpr size_t MASK        = props.mask();
+    constexpr Algorithm::Id BASE = props.base();
+
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    constexpr bool IS_CN_HEAVY_TUBE = ALGO == Algorithm::CN_HEAVY_TUBE;
+    constexpr bool IS_CN_HEAVY_XHV  = ALGO == Algorithm::CN_HEAVY_XHV;
+#   else
+    constexpr bool IS_CN_HEAVY_TUBE = false;
+    constexpr bool IS_CN_HEAVY_XHV  = false;
+#   endif
+
+    if (BASE == Algorithm::CN_1 && size < 43) {
+        memset(output, 0, 32 * 8);
+        return;
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        keccak(input + size * i, size, ctx[i]->state);
+        if (props.half_mem()) {
+            ctx[i]->first_half = true;
+        }
+    }
+
+#   ifdef XMRIG_VAES512
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes512_enabled) {
+        cn_explode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+        cn_explode_scratchpad_vaes512_quad(ctx + 4, props.memory(), props.half_mem());
+    }
+    else
+#   endif
+#   ifdef XMRIG_VAES
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
+        for (size_t i = 0; i < 8; i += 2) {
+            cn_explode_scratchpad_vaes_double(ctx[i], ctx[i + 1], props.memory(), props.half_mem());
+        }
+    }
+    else
+#   endif
+    {
+        for (size_t i = 0; i < 8; i++) {
+            cn_explode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
+        }
+    }
+
+    uint8_t* l0  = ctx[0]->memory;
+    uint8_t* l1  = ctx[1]->memory;
+    uint8_t* l2  = ctx[2]->memory;
+    uint8_t* l3  = ctx[3]->memory;
+    uint8_t* l4  = ctx[4]->memory;
+    uint8_t* l5  = ctx[5]->memory;
+    uint8_t* l6  = ctx[6]->memory;
+    uint8_t* l7  = ctx[7]->memory;
+    uint64_t* h0 = reinterpret_cast<uint64_t*>(ctx[0]->state);
+    uint64_t* h1 = reinterpret_cast<uint64_t*>(ctx[1]->state);
+    uint64_t* h2 = reinterpret_cast<uint64_t*>(ctx[2]->state);
+    uint64_t* h3 = reinterpret_cast<uint64_t*>(ctx[3]->state);
+    uint64_t* h4 = reinterpret_cast<uint64_t*>(ctx[4]->state);
+    uint64_t* h5 = reinterpret_cast<uint64_t*>(ctx[5]->state);
+    uint64_t* h6 = reinterpret_cast<uint64_t*>(ctx[6]->state);
+    uint64_t* h7 = reinterpret_cast<uint64_t*>(ctx[7]->state);
+
+    CONST_INIT(ctx[0], 0);
+    CONST_INIT(ctx[1], 1);
+    CONST_INIT(ctx[2], 2);
+    CONST_INIT(ctx[3], 3);
+    CONST_INIT(ctx[4], 4);
+    CONST_INIT(ctx[5], 5);
+    CONST_INIT(ctx[6], 6);
+    CONST_INIT(ctx[7], 7);
+    VARIANT2_SET_ROUNDING_MODE();
+    if (ALGO == Algorithm::CN_CCX) {
+        RESTORE_ROUNDING_MODE();
+    }
+
+    uint64_t idx0, idx1, idx2, idx3, idx4, idx5, idx6, idx7;
+    idx0 = _mm_cvtsi128_si64(ax0);
+    idx1 = _mm_cvtsi128_si64(ax1);
+    idx2 = _mm_cvtsi128_si64(ax2);
+    idx3 = _mm_cvtsi128_si64(ax3);
+    idx4 = _mm_cvtsi128_si64(ax4);
+    idx5 = _mm_cvtsi128_si64(ax5);
+    idx6 = _mm_cvtsi128_si64(ax6);
+    idx7 = _mm_cvtsi128_si64(ax7);
+
+    for (size_t i = 0; i < props.iterations(); i++) {
+        uint64_t hi, lo;
+        __m128i *ptr0, *ptr1, *ptr2, *ptr3, *ptr4, *ptr5, *ptr6, *ptr7;
+
+        CN_STEP1(ax0, bx00, bx01, cx0, l0, ptr0, idx0, conc_var0);
+        CN_STEP1(ax1, bx10, bx11, cx1, l1, ptr1, idx1, conc_var1);
+        CN_STEP1(ax2, bx20, bx21, cx2, l2, ptr2, idx2, conc_var2);
+        CN_STEP1(ax3, bx30, bx31, cx3, l3, ptr3, idx3, conc_var3);
+        CN_STEP1(ax4, bx40, bx41, cx4, l4, ptr4, idx4, conc_var4);
+        CN_STEP1(ax5, bx50, bx51, cx5, l5, ptr5, idx5, conc_var5);
+        CN_STEP1(ax6, bx60, bx61, cx6, l6, ptr6, idx6, conc_var6);
+        CN_STEP1(ax7, bx70, bx71, cx7, l7, ptr7, idx7, conc_var7);
+
+        CN_STEP2(ax0, bx00, bx01, cx0, l0, ptr0, idx0);
+        CN_STEP2(ax1, bx10, bx11, cx1, l1, ptr1, idx1);
+        CN_STEP2(ax2, bx20, bx21, cx2, l2, ptr2, idx2);
+        CN_STEP2(ax3, bx30, bx31, cx3, l3, ptr3, idx3);
+        CN_STEP2(ax4, bx40, bx41, cx4, l4, ptr4, idx4);
+        CN_STEP2(ax5, bx50, bx51, cx5, l5, ptr5, idx5);
+        CN_STEP2(ax6, bx60, bx61, cx6, l6, ptr6, idx6);
+        CN_STEP2(ax7, bx70, bx71, cx7, l7, ptr7, idx7);
+
+        CN_STEP3(0, ax0, bx00, bx01, cx0, l0, ptr0, idx0);
+        CN_STEP3(1, ax1, bx10, bx11, cx1, l1, ptr1, idx1);
+        CN_STEP3(2, ax2, bx20, bx21, cx2, l2, ptr2, idx2);
+        CN_STEP3(3, ax3, bx30, bx31, cx3, l3, ptr3, idx3);
+        CN_STEP3(4, ax4, bx40, bx41, cx4, l4, ptr4, idx4);
+        CN_STEP3(5, ax5, bx50, bx51, cx5, l5, ptr5, idx5);
+        CN_STEP3(6, ax6, bx60, bx61, cx6, l6, ptr6, idx6);
+        CN_STEP3(7, ax7, bx70, bx71, cx7, l7, ptr7, idx7);
+
+        CN_STEP4(0, ax0, bx00, bx01, cx0, l0, mc0, ptr0, idx0);
+        CN_STEP4(1, ax1, bx10, bx11, cx1, l1, mc1, ptr1, idx1);
+        CN_STEP4(2, ax2, bx20, bx21, cx2, l2, mc2, ptr2, idx2);
+        CN_STEP4(3, ax3, bx30, bx31, cx3, l3, mc3, ptr3, idx3);
+        CN_STEP4(4, ax4, bx40, bx41, cx4, l4, mc4, ptr4, idx4);
+        CN_STEP4(5, ax5, bx50, bx51, cx5, l5, mc5, ptr5, idx5);
+        CN_STEP4(6, ax6, bx60, bx61, cx6, l6, mc6, ptr6, idx6);
+        CN_STEP4(7, ax7, bx70, bx71, cx7, l7, mc7, ptr7, idx7);
+    }
+
+#   ifdef XMRIG_VAES512
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes512_enabled) {
+        cn_implode_scratchpad_vaes512_quad(ctx, props.memory(), props.half_mem());
+        cn_implode_scratchpad_vaes512_quad(ctx + 4, props.memory(), props.half_mem());
+    }
+    else
+#   endif
+#   ifdef XMRIG_VAES
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
+        for (size_t i = 0; i < 8; i += 2) {
+            cn_implode_scratchpad_vaes_double(ctx[i], ctx[i + 1], props.memory(), props.half_mem());
+        }
+    }
+    else
+#   endif
+    {
+        for (size_t i = 0; i < 8; i++) {
+            cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
+        }
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        keccakf(reinterpret_cast<uint64_t*>(ctx[i]->state), 24);
+        extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
+    }
+}
+
+
 } /* namespace xmrig */
 
 
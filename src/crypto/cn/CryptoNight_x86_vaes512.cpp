@@ -0,0 +1,282 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CryptoNight_x86_vaes.h"
+#include "CryptoNight_monero.h"
+#include "CryptoNight.h"
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+
+// Each 512-bit register holds the same 128-bit block of 4 independent hashes: lane i belongs to ctx[i].
+
+
+static FORCEINLINE __m128i sl_xor(__m128i tmp1)
+{
+    __m128i tmp4;
+    tmp4 = _mm_slli_si128(tmp1, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    return tmp1;
+}
+
+
+template<uint8_t rcon>
+static FORCEINLINE void aes_genkey_sub(__m128i* xout0, __m128i* xout2)
+{
+    __m128i xout1 = _mm_aeskeygenassist_si128(*xout2, rcon);
+    xout1 = _mm_shuffle_epi32(xout1, 0xFF); // see PSHUFD, set all elems to 4th elem
+    *xout0 = sl_xor(*xout0);
+    *xout0 = _mm_xor_si128(*xout0, xout1);
+    xout1 = _mm_aeskeygenassist_si128(*xout0, 0x00);
+    xout1 = _mm_shuffle_epi32(xout1, 0xAA); // see PSHUFD, set all elems to 3rd elem
+    *xout2 = sl_xor(*xout2);
+    *xout2 = _mm_xor_si128(*xout2, xout1);
+}
+
+
+static FORCEINLINE __m512i load_quad(const __m128i* p0, const __m128i* p1, const __m128i* p2, const __m128i* p3)
+{
+    __m512i x = _mm512_inserti32x4(_mm512_setzero_si512(), _mm_loadu_si128(p0), 0);
+    x = _mm512_inserti32x4(x, _mm_loadu_si128(p1), 1);
+    x = _mm512_inserti32x4(x, _mm_loadu_si128(p2), 2);
+    return _mm512_inserti32x4(x, _mm_loadu_si128(p3), 3);
+}
+
+
+static FORCEINLINE __m512i set_quad(__m128i x0, __m128i x1, __m128i x2, __m128i x3)
+{
+    __m512i x = _mm512_inserti32x4(_mm512_setzero_si512(), x0, 0);
+    x = _mm512_inserti32x4(x, x1, 1);
+    x = _mm512_inserti32x4(x, x2, 2);
+    return _mm512_inserti32x4(x, x3, 3);
+}
+
+
+static FORCEINLINE void store_quad(__m128i* p0, __m128i* p1, __m128i* p2, __m128i* p3, __m512i x)
+{
+    _mm_storeu_si128(p0, _mm512_mask_extracti32x4_epi32(_mm_setzero_si128(), 0xF, x, 0));
+    _mm_storeu_si128(p1, _mm512_mask_extracti32x4_epi32(_mm_setzero_si128(), 0xF, x, 1));
+    _mm_storeu_si128(p2, _mm512_mask_extracti32x4_epi32(_mm_setzero_si128(), 0xF, x, 2));
+    _mm_storeu_si128(p3, _mm512_mask_extracti32x4_epi32(_mm_setzero_si128(), 0xF, x, 3));
+}
+
+
+static NOINLINE void vaes512_genkey_quad(const __m128i* const* memory, __m512i* k)
+{
+    __m128i xout0[4];
+    __m128i xout2[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        xout0[i] = _mm_load_si128(memory[i]);
+        xout2[i] = _mm_load_si128(memory[i] + 1);
+    }
+
+    k[0] = set_quad(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[1] = set_quad(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x01>(&xout0[i], &xout2[i]); }
+    k[2] = set_quad(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[3] = set_quad(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x02>(&xout0[i], &xout2[i]); }
+    k[4] = set_quad(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[5] = set_quad(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x04>(&xout0[i], &xout2[i]); }
+    k[6] = set_quad(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[7] = set_quad(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x08>(&xout0[i], &xout2[i]); }
+    k[8] = set_quad(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[9] = set_quad(xout2[0], xout2[1], xout2[2], xout2[3]);
+}
+
+
+static FORCEINLINE void vaes512_round(__m512i key, __m512i& x0, __m512i& x1, __m512i& x2, __m512i& x3, __m512i& x4, __m512i& x5, __m512i& x6, __m512i& x7)
+{
+    x0 = _mm512_aesenc_epi128(x0, key);
+    x1 = _mm512_aesenc_epi128(x1, key);
+    x2 = _mm512_aesenc_epi128(x2, key);
+    x3 = _mm512_aesenc_epi128(x3, key);
+    x4 = _mm512_aesenc_epi128(x4, key);
+    x5 = _mm512_aesenc_epi128(x5, key);
+    x6 = _mm512_aesenc_epi128(x6, key);
+    x7 = _mm512_aesenc_epi128(x7, key);
+}
+
+
+static FORCEINLINE void vaes512_rounds(const __m512i* k, __m512i* x)
+{
+    for (size_t i = 0; i < 10; ++i) {
+        vaes512_round(k[i], x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]);
+    }
+}
+
+
+namespace xmrig {
+
+
+NOINLINE void cn_explode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m512i xin[8];
+    __m512i k[10];
+
+    const __m128i* input[4];
+    __m128i* output[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        input[i]  = reinterpret_cast<const __m128i*>(ctx[i]->state);
+        output[i] = reinterpret_cast<__m128i*>(ctx[i]->memory);
+    }
+
+    vaes512_genkey_quad(input, k);
+
+    {
+        const bool b = half_mem && !ctx[0]->first_half && !ctx[1]->first_half && !ctx[2]->first_half && !ctx[3]->first_half;
+
+        const __m128i* p[4];
+        for (size_t i = 0; i < 4; ++i) {
+            p[i] = b ? reinterpret_cast<const __m128i*>(ctx[i]->save_state) : (input[i] + 4);
+        }
+
+        for (size_t j = 0; j < 8; ++j) {
+            xin[j] = load_quad(p[0] + j, p[1] + j, p[2] + j, p[3] + j);
+        }
+    }
+
+    constexpr int output_increment = 64 / sizeof(__m128i);
+    constexpr int prefetch_dist = 2048 / sizeof(__m128i);
+
+    __m128i* e = output[0] + N - prefetch_dist;
+    size_t prefetch_offset = prefetch_dist;
+
+    for (int i = 0; i < 2; ++i) {
+        do {
+            for (size_t c = 0; c < 4; ++c) {
+                _mm_prefetch((const char*)(output[c] + prefetch_offset), _MM_HINT_T0);
+                _mm_prefetch((const char*)(output[c] + prefetch_offset + output_increment), _MM_HINT_T0);
+            }
+
+            vaes512_rounds(k, xin);
+
+            for (size_t j = 0; j < 8; ++j) {
+                store_quad(output[0] + j, output[1] + j, output[2] + j, output[3] + j, xin[j]);
+            }
+
+            for (size_t c = 0; c < 4; ++c) {
+                output[c] += output_increment * 2;
+            }
+        } while (output[0] < e);
+        e += prefetch_dist;
+        prefetch_offset = 0;
+    }
+
+    if (half_mem && ctx[0]->first_half && ctx[1]->first_half && ctx[2]->first_half && ctx[3]->first_half) {
+        __m128i* p[4];
+        for (size_t i = 0; i < 4; ++i) {
+            p[i] = reinterpret_cast<__m128i*>(ctx[i]->save_state);
+        }
+
+        for (size_t j = 0; j < 8; ++j) {
+            store_quad(p[0] + j, p[1] + j, p[2] + j, p[3] + j, xin[j]);
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+
+NOINLINE void cn_implode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m512i xout[8];
+    __m512i k[10];
+
+    const __m128i* input[4];
+    const __m128i* input_begin[4];
+    __m128i* output[4];
+    const __m128i* keys[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        input[i]       = reinterpret_cast<const __m128i*>(ctx[i]->memory);
+        input_begin[i] = input[i];
+        output[i]      = reinterpret_cast<__m128i*>(ctx[i]->state);
+        keys[i]        = output[i] + 2;
+    }
+
+    vaes512_genkey_quad(keys, k);
+
+    for (size_t j = 0; j < 8; ++j) {
+        xout[j] = load_quad(output[0] + 4 + j, output[1] + 4 + j, output[2] + 4 + j, output[3] + 4 + j);
+    }
+
+    for (size_t part = 0; part < (half_mem ? 2 : 1); ++part) {
+        if (half_mem && (part == 1)) {
+            for (size_t i = 0; i < 4; ++i) {
+                input[i] = input_begin[i];
+                ctx[i]->first_half = false;
+            }
+
+            cn_explode_scratchpad_vaes512_quad(ctx, memory, half_mem);
+        }
+
+        for (size_t i = 0; i < N;) {
+            for (size_t j = 0; j < 8; ++j) {
+                xout[j] = _mm512_xor_si512(load_quad(input[0] + j, input[1] + j, input[2] + j, input[3] + j), xout[j]);
+            }
+
+            constexpr int input_increment = 64 / sizeof(__m128i);
+
+            for (size_t c = 0; c < 4; ++c) {
+                input[c] += input_increment * 2;
+            }
+
+            i += 8;
+
+            if (i < N) {
+                for (size_t c = 0; c < 4; ++c) {
+                    _mm_prefetch((const char*)(input[c]), _MM_HINT_T0);
+                    _mm_prefetch((const char*)(input[c] + input_increment), _MM_HINT_T0);
+                }
+            }
+
+            vaes512_rounds(k, xout);
+        }
+    }
+
+    for (size_t j = 0; j < 8; ++j) {
+        store_quad(output[0] + 4 + j, output[1] + 4 + j, output[2] + 4 + j, output[3] + 4 + j, xout[j]);
+    }
+
+    _mm256_zeroupper();
+}
+
+
+} // xmrig
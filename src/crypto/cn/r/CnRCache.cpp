@@ -0,0 +1,160 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/r/CnRCache.h"
+#include "base/tools/Chrono.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/document.h"
+#endif
+
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+struct CnRCacheEntry
+{
+    inline bool match(Algorithm::Id a, uint64_t h, CnRCache::Variant v, Assembly::Id id) const
+    {
+        return height == h && algo == a && variant == v && ASM == id;
+    }
+
+    Algorithm::Id algo          = Algorithm::INVALID;
+    Assembly::Id ASM            = Assembly::NONE;
+    CnRCache::Variant variant   = CnRCache::SINGLE;
+    size_t refs                 = 0;
+    uint64_t height             = 0;
+    void *code                  = nullptr;
+};
+
+
+static std::mutex mutex;
+static std::vector<CnRCacheEntry> entries;
+
+static uint64_t generated      = 0;
+static uint64_t hits           = 0;
+static uint64_t freed          = 0;
+static double totalTime        = 0.0;
+static double maxTime          = 0.0;
+
+
+static void releaseLocked(void *code)
+{
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->code != code) {
+            continue;
+        }
+
+        if (--it->refs == 0) {
+            VirtualMemory::freeLargePagesMemory(it->code, CnRCache::kCodeSize);
+            entries.erase(it);
+            ++freed;
+        }
+
+        return;
+    }
+}
+
+
+} // namespace xmrig
+
+
+cn_mainloop_fun_ms_abi xmrig::CnRCache::acquire(Algorithm::Id algo, uint64_t height, Variant variant, Assembly::Id ASM, Generator generator, cn_mainloop_fun_ms_abi prev)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    void *code = nullptr;
+
+    for (auto &entry : entries) {
+        if (entry.match(algo, height, variant, ASM)) {
+            ++entry.refs;
+            ++hits;
+            code = entry.code;
+            break;
+        }
+    }
+
+    if (!code) {
+        const double start = Chrono::highResolutionMSecs();
+
+        code = VirtualMemory::allocateExecutableMemory(kCodeSize, false);
+        generator(height, code, ASM);
+        VirtualMemory::protectRX(code, kCodeSize);
+
+        const double elapsed = Chrono::highResolutionMSecs() - start;
+        totalTime += elapsed;
+        maxTime    = std::max(maxTime, elapsed);
+        ++generated;
+
+        CnRCacheEntry entry;
+        entry.algo    = algo;
+        entry.ASM     = ASM;
+        entry.variant = variant;
+        entry.refs    = 1;
+        entry.height  = height;
+        entry.code    = code;
+
+        entries.emplace_back(entry);
+    }
+
+    if (prev) {
+        releaseLocked(reinterpret_cast<void *>(prev));
+    }
+
+    return reinterpret_cast<cn_mainloop_fun_ms_abi>(code);
+}
+
+
+void xmrig::CnRCache::release(cn_mainloop_fun_ms_abi code)
+{
+    if (!code) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    releaseLocked(reinterpret_cast<void *>(code));
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CnRCache::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Value out(kObjectType);
+    out.AddMember("programs",   static_cast<uint64_t>(entries.size()), allocator);
+    out.AddMember("generated",  generated, allocator);
+    out.AddMember("hits",       hits, allocator);
+    out.AddMember("freed",      freed, allocator);
+    out.AddMember("time_total", totalTime, allocator);
+    out.AddMember("time_max",   maxTime, allocator);
+
+    return out;
+}
+#endif
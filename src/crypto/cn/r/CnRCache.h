@@ -0,0 +1,69 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CNRCACHE_H
+#define XMRIG_CNRCACHE_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/Assembly.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+/**
+ * Process wide cache of compiled CryptonightR main loops.
+ *
+ * Programs are keyed by algorithm, height, code layout and assembly flavour, every context holds one
+ * reference to the program it currently executes. Pages are generated once, switched to read-only
+ * executable and released when the last context moves to another height.
+ */
+class CnRCache
+{
+public:
+    enum Variant : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES
+    };
+
+    using Generator = void (*)(uint64_t height, void *machine_code, Assembly::Id ASM);
+
+    constexpr static size_t kCodeSize = 0x4000;
+
+    static cn_mainloop_fun_ms_abi acquire(Algorithm::Id algo, uint64_t height, Variant variant, Assembly::Id ASM, Generator generator, cn_mainloop_fun_ms_abi prev);
+    static void release(cn_mainloop_fun_ms_abi code);
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CNRCACHE_H */
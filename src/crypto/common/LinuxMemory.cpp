@@ -22,6 +22,7 @@
 
 
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <mutex>
 #include <string>
@@ -64,6 +65,69 @@ bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize
 }
 
 
+bool xmrig::LinuxMemory::isTransparentHugePagesAvailable()
+{
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string mode;
+    std::getline(file, mode);
+
+    return mode.find("[never]") == std::string::npos;
+}
+
+
+size_t xmrig::LinuxMemory::anonHugePages(const std::vector<Mapping> &mappings, const void *p, size_t size)
+{
+    const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+    const uintptr_t end   = start + size;
+    size_t out            = 0;
+
+    for (const Mapping &mapping : mappings) {
+        if (mapping.end <= start || mapping.start >= end) {
+            continue;
+        }
+
+        // A mapping can be shared with neighbour allocations, never count more than the overlapping part
+        const size_t overlap = std::min(end, mapping.end) - std::max(start, mapping.start);
+        out += std::min(mapping.anonHugePages, overlap);
+    }
+
+    return std::min(out, size);
+}
+
+
+std::vector<xmrig::LinuxMemory::Mapping> xmrig::LinuxMemory::mappings()
+{
+    std::vector<Mapping> out;
+
+    FILE *file = fopen("/proc/self/smaps", "r");
+    if (!file) {
+        return out;
+    }
+
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long long start = 0;
+        unsigned long long end   = 0;
+        unsigned long long kb    = 0;
+
+        if (sscanf(line, "%llx-%llx ", &start, &end) == 2) {
+            out.push_back({ static_cast<uintptr_t>(start), static_cast<uintptr_t>(end), 0 });
+        }
+        else if (!out.empty() && sscanf(line, "AnonHugePages: %llu kB", &kb) == 1) {
+            out.back().anonHugePages = static_cast<size_t>(kb) * 1024;
+        }
+    }
+
+    fclose(file);
+
+    return out;
+}
+
+
 bool xmrig::LinuxMemory::write(const char *path, uint64_t value)
 {
     std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 
 
 namespace xmrig {
@@ -30,7 +31,17 @@ namespace xmrig {
 class LinuxMemory
 {
 public:
+    struct Mapping
+    {
+        uintptr_t start;
+        uintptr_t end;
+        size_t anonHugePages;
+    };
+
     static bool reserve(size_t size, uint32_t node, size_t hugePageSize);
+    static bool isTransparentHugePagesAvailable();
+    static size_t anonHugePages(const std::vector<Mapping> &mappings, const void *p, size_t size);
+    static std::vector<Mapping> mappings();
 
     static bool write(const char *path, uint64_t value);
     static int64_t read(const char *path);
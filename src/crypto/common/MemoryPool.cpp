@@ -50,6 +50,7 @@ xmrig::MemoryPool::MemoryPool(size_t size, bool hugePages, uint32_t node)
     constexpr size_t alignment = 1 << 24;
 
     m_memory = new VirtualMemory(size * pageSize + alignment, hugePages, false, false, node);
+    m_memory->setTag("pool");
 
     m_alignOffset = (alignment - (((size_t)m_memory->scratchpad()) % alignment)) % alignment;
 }
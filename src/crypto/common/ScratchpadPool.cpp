@@ -0,0 +1,167 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/common/ScratchpadPool.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/document.h"
+#endif
+
+
+#include <iterator>
+#include <map>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+static const char *kRetainedTag = "scratchpad-retained";
+static const char *kTag         = "scratchpad";
+
+
+static std::mutex mutex;
+static std::map<uint32_t, std::multimap<size_t, VirtualMemory *> > retained;
+
+static uint64_t hits            = 0;
+static uint64_t misses          = 0;
+static uint64_t evicted         = 0;
+static uint64_t retainedBytes   = 0;
+
+
+static inline bool isRetainable(const VirtualMemory *memory)
+{
+    // Pooled memory goes back to its pool, regular pages are cheap to get again
+    return !memory->isPooled() && (memory->isHugePages() || memory->isOneGbPages() || memory->isTransparentHugePages());
+}
+
+
+} // namespace xmrig
+
+
+xmrig::VirtualMemory *xmrig::ScratchpadPool::acquire(size_t size, bool hugePages, uint32_t node)
+{
+    if (!hugePages) {
+        return new VirtualMemory(size, false, false, true, node);
+    }
+
+    const size_t sizeClass = VirtualMemory::align(size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto &regions = retained[node];
+        auto it       = regions.lower_bound(sizeClass);
+
+        if (it != regions.end() && it->first <= sizeClass * 2) {
+            VirtualMemory *memory = it->second;
+            regions.erase(it);
+
+            retainedBytes -= memory->size();
+            ++hits;
+
+            memory->setTag(kTag);
+
+            return memory;
+        }
+
+        ++misses;
+
+        // Nothing here fits the new size, give back at least as many pages as the new region needs
+        size_t freed = 0;
+        while (!regions.empty() && freed < sizeClass) {
+            auto last = std::prev(regions.end());
+
+            freed         += last->first;
+            retainedBytes -= last->first;
+            ++evicted;
+
+            delete last->second;
+            regions.erase(last);
+        }
+    }
+
+    auto memory = new VirtualMemory(sizeClass, true, false, true, node);
+    memory->setTag(kTag);
+
+    return memory;
+}
+
+
+void xmrig::ScratchpadPool::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &kv : retained) {
+        for (auto &region : kv.second) {
+            delete region.second;
+        }
+    }
+
+    retained.clear();
+    retainedBytes = 0;
+}
+
+
+void xmrig::ScratchpadPool::release(VirtualMemory *memory)
+{
+    if (!memory) {
+        return;
+    }
+
+    if (!isRetainable(memory)) {
+        delete memory;
+
+        return;
+    }
+
+    memory->setTag(kRetainedTag);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    retained[memory->node()].insert({ memory->size(), memory });
+    retainedBytes += memory->size();
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::ScratchpadPool::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t count = 0;
+    for (const auto &kv : retained) {
+        count += kv.second.size();
+    }
+
+    Value out(kObjectType);
+    out.AddMember("retained",       static_cast<uint64_t>(count), allocator);
+    out.AddMember("retained_bytes", retainedBytes, allocator);
+    out.AddMember("hits",           hits, allocator);
+    out.AddMember("misses",         misses, allocator);
+    out.AddMember("evicted",        evicted, allocator);
+
+    return out;
+}
+#endif
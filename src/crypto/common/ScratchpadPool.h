@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SCRATCHPADPOOL_H
+#define XMRIG_SCRATCHPADPOOL_H
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/fwd.h"
+#endif
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+class VirtualMemory;
+
+
+/**
+ * Process wide cache of worker scratchpads.
+ *
+ * Released huge page backed regions are kept per NUMA node instead of being unmapped, so a worker restart
+ * (algorithm switch, donation round, config change) gets them back even if the OS has no free huge pages left.
+ * Regions are sized in 2 MB classes and a request is served by the smallest retained region of its class
+ * or up to twice its class. A miss evicts retained regions of the node first to return their pages to the OS.
+ */
+class ScratchpadPool
+{
+public:
+    static VirtualMemory *acquire(size_t size, bool hugePages, uint32_t node);
+    static void clear();
+    static void release(VirtualMemory *memory);
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SCRATCHPADPOOL_H */
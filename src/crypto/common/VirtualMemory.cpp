@@ -23,6 +23,7 @@
 #include "base/io/log/Log.h"
 #include "crypto/common/MemoryPool.h"
 #include "crypto/common/portable/mm_malloc.h"
+#include "crypto/common/ScratchpadPool.h"
 
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -30,8 +31,20 @@
 #endif
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/common/LinuxMemory.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/document.h"
+#endif
+
+
 #include <cinttypes>
+#include <map>
 #include <mutex>
+#include <set>
 
 
 namespace xmrig {
@@ -42,6 +55,45 @@ static IMemoryPool *pool                = nullptr;
 static std::mutex mutex;
 
 
+static const char *kTierNames[VirtualMemory::TIER_MAX] = { "4k", "thp", "hugetlb", "1gb" };
+
+
+// Every live allocation, so the API can report where each of them landed
+struct Regions
+{
+    std::mutex mutex;
+    std::set<const VirtualMemory *> memory;
+    std::map<const void *, size_t> executable;
+};
+
+
+// Measured regions take a generation number once allocated, a /proc/self/smaps snapshot serves every region of
+// an older generation, so a batch of allocations (all workers of a profile) is parsed once instead of per region
+static std::mutex coverageMutex;
+static uint64_t generation          = 0;
+
+#ifdef XMRIG_OS_LINUX
+static uint64_t snapshotGeneration  = 0;
+
+static std::vector<LinuxMemory::Mapping> &snapshot()
+{
+    static auto *mappings = new std::vector<LinuxMemory::Mapping>();
+
+    return *mappings;
+}
+#endif
+
+
+// Constructed on first use and never destroyed: static objects of other translation units (CnHash) allocate
+// executable memory before this file's globals are initialized and may free it after they are destroyed
+static Regions &regions()
+{
+    static auto *instance = new Regions();
+
+    return *instance;
+}
+
+
 } // namespace xmrig
 
 
@@ -50,36 +102,30 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
     m_node(node),
     m_capacity(m_size)
 {
-    if (usePool) {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (hugePages && !pool->isHugePages(node) && allocateLargePagesMemory()) {
-            return;
-        }
-
-        m_scratchpad = pool->get(m_size, node);
-        if (m_scratchpad) {
-            m_flags.set(FLAG_HUGEPAGES, pool->isHugePages(node));
-            m_flags.set(FLAG_EXTERNAL,  true);
+    allocate(size, hugePages, oneGbPages, usePool, alignSize);
 
-            return;
-        }
+    if (isHugePages() || isOneGbPages()) {
+        m_coverage = m_size;
     }
-
-    if (oneGbPages && allocateOneGbPagesMemory()) {
-        m_capacity = align(size, 1ULL << 30);
-        return;
+    else if (isTransparentHugePages() || m_flags.test(FLAG_EXTERNAL)) {
+        std::lock_guard<std::mutex> lock(coverageMutex);
+        m_generation = ++generation;
     }
 
-    if (hugePages && allocateLargePagesMemory()) {
-        return;
-    }
-
-    m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, alignSize));
+    Regions &r = regions();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.memory.insert(this);
 }
 
 
 xmrig::VirtualMemory::~VirtualMemory()
 {
+    {
+        Regions &r = regions();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.memory.erase(this);
+    }
+
     if (!m_scratchpad) {
         return;
     }
@@ -88,7 +134,7 @@ xmrig::VirtualMemory::~VirtualMemory()
         std::lock_guard<std::mutex> lock(mutex);
         pool->release(m_node);
     }
-    else if (isHugePages() || isOneGbPages()) {
+    else if (isHugePages() || isOneGbPages() || isTransparentHugePages()) {
         freeLargePagesMemory();
     }
     else {
@@ -103,6 +149,171 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 }
 
 
+size_t xmrig::VirtualMemory::hugePagesCoverage() const
+{
+    std::lock_guard<std::mutex> lock(coverageMutex);
+
+    if (m_generation) {
+        m_coverage   = coverage(m_scratchpad, m_size, m_generation);
+        m_generation = 0;
+    }
+
+    return m_coverage;
+}
+
+
+xmrig::VirtualMemory::Tier xmrig::VirtualMemory::tier() const
+{
+    if (isOneGbPages()) {
+        return TIER_1GB;
+    }
+
+    if (isHugePages()) {
+        return TIER_HUGETLB;
+    }
+
+    // Pooled memory inherits the tier of the pool, the measured coverage tells whether it landed on THP
+    return (isTransparentHugePages() || (m_flags.test(FLAG_EXTERNAL) && hugePagesCoverage() > 0)) ? TIER_THP : TIER_DEFAULT;
+}
+
+
+const char *xmrig::VirtualMemory::tierName(Tier tier)
+{
+    return tier < TIER_MAX ? kTierNames[tier] : "unknown";
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::VirtualMemory::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+#   ifdef XMRIG_OS_LINUX
+    const auto mappings = LinuxMemory::mappings();
+#   endif
+
+    // Coverage is measured again on every request, the kernel can split or collapse transparent huge pages at any time
+    auto measure = [&](const void *p, size_t size, Tier tier) -> double {
+        if (tier == TIER_HUGETLB || tier == TIER_1GB) {
+            return 100.0;
+        }
+
+#       ifdef XMRIG_OS_LINUX
+        return size ? static_cast<double>(LinuxMemory::anonHugePages(mappings, p, size)) / size * 100.0 : 0.0;
+#       else
+        return 0.0;
+#       endif
+    };
+
+    Regions &r = regions();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    Value out(kArrayType);
+
+    for (const VirtualMemory *memory : r.memory) {
+        if (!memory->m_scratchpad) {
+            continue;
+        }
+
+        Value region(kObjectType);
+        region.AddMember("tag",     StringRef(memory->tag()), allocator);
+        region.AddMember("node",    memory->m_node, allocator);
+        region.AddMember("size",    static_cast<uint64_t>(memory->size()), allocator);
+        region.AddMember("tier",    StringRef(tierName(memory->tier())), allocator);
+        region.AddMember("pooled",  memory->m_flags.test(FLAG_EXTERNAL), allocator);
+        region.AddMember("huge",    measure(memory->m_scratchpad, memory->size(), memory->tier()), allocator);
+
+        out.PushBack(region, allocator);
+    }
+
+    if (!r.executable.empty()) {
+        size_t size     = 0;
+        double huge     = 0.0;
+
+        for (const auto &kv : r.executable) {
+            size += kv.second;
+            huge += measure(kv.first, kv.second, TIER_DEFAULT) * kv.second;
+        }
+
+        Value region(kObjectType);
+        region.AddMember("tag",     "jit", allocator);
+        region.AddMember("count",   static_cast<uint64_t>(r.executable.size()), allocator);
+        region.AddMember("size",    static_cast<uint64_t>(size), allocator);
+        region.AddMember("tier",    StringRef(tierName(huge > 0.0 ? TIER_THP : TIER_DEFAULT)), allocator);
+        region.AddMember("huge",    size ? huge / size : 0.0, allocator);
+
+        out.PushBack(region, allocator);
+    }
+
+    return out;
+}
+#endif
+
+
+size_t xmrig::VirtualMemory::coverage(const void *p, size_t size, uint64_t required)
+{
+#   ifdef XMRIG_OS_LINUX
+    if (snapshotGeneration < required) {
+        snapshotGeneration = generation;
+        snapshot()         = LinuxMemory::mappings();
+    }
+
+    return LinuxMemory::anonHugePages(snapshot(), p, size);
+#   else
+    return 0;
+#   endif
+}
+
+
+void xmrig::VirtualMemory::addExecutable(void *p, size_t size)
+{
+    if (p) {
+        Regions &r = regions();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.executable[p] = size;
+    }
+}
+
+
+void xmrig::VirtualMemory::removeExecutable(void *p)
+{
+    Regions &r = regions();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.executable.erase(p);
+}
+
+
+void xmrig::VirtualMemory::allocate(size_t size, bool hugePages, bool oneGbPages, bool usePool, size_t alignSize)
+{
+    if (usePool) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hugePages && !pool->isHugePages(m_node) && allocateLargePagesMemory()) {
+            return;
+        }
+
+        m_scratchpad = pool->get(m_size, m_node);
+        if (m_scratchpad) {
+            m_flags.set(FLAG_HUGEPAGES, pool->isHugePages(m_node));
+            m_flags.set(FLAG_EXTERNAL,  true);
+
+            return;
+        }
+    }
+
+    if (oneGbPages && allocateOneGbPagesMemory()) {
+        m_capacity = align(size, 1ULL << 30);
+        return;
+    }
+
+    if (hugePages && (allocateLargePagesMemory() || allocateTransparentHugePagesMemory())) {
+        return;
+    }
+
+    m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, alignSize));
+}
+
+
 #ifndef XMRIG_FEATURE_HWLOC
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
@@ -113,6 +324,8 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 
 void xmrig::VirtualMemory::destroy()
 {
+    ScratchpadPool::clear();
+
     delete pool;
 }
 
@@ -123,6 +336,12 @@ void xmrig::VirtualMemory::init(size_t poolSize, size_t hugePageSize)
         osInit(hugePageSize);
     }
 
+    initPool(poolSize, hugePageSize);
+}
+
+
+void xmrig::VirtualMemory::initPool(size_t poolSize, size_t hugePageSize)
+{
 #   ifdef XMRIG_FEATURE_HWLOC
     if (Cpu::info()->nodes() > 1) {
         pool = new NUMAMemoryPool(align(poolSize, Cpu::info()->nodes()), hugePageSize > 0);
@@ -25,6 +25,11 @@
 #include "crypto/common/HugePagesInfo.h"
 
 
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/fwd.h"
+#endif
+
+
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
@@ -42,19 +47,38 @@ public:
     constexpr static size_t kDefaultHugePageSize    = 2U * 1024U * 1024U;
     constexpr static size_t kOneGiB                 = 1024U * 1024U * 1024U;
 
+    // Allocation fallback chain: 1 GB pages -> hugetlb pages -> transparent huge pages (Linux) -> regular pages
+    enum Tier : uint32_t {
+        TIER_DEFAULT,
+        TIER_THP,
+        TIER_HUGETLB,
+        TIER_1GB,
+        TIER_MAX
+    };
+
     VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
     ~VirtualMemory();
 
     inline bool isHugePages() const                                 { return m_flags.test(FLAG_HUGEPAGES); }
     inline bool isOneGbPages() const                                { return m_flags.test(FLAG_1GB_PAGES); }
+    inline bool isPooled() const                                    { return m_flags.test(FLAG_EXTERNAL); }
+    inline bool isTransparentHugePages() const                      { return m_flags.test(FLAG_THP); }
+    inline const char *tag() const                                  { return m_tag; }
+    inline uint32_t node() const                                    { return m_node; }
     inline size_t size() const                                      { return m_size; }
     inline size_t capacity() const                                  { return m_capacity; }
     inline uint8_t *raw() const                                     { return m_scratchpad; }
     inline uint8_t *scratchpad() const                              { return m_scratchpad; }
 
+    inline void setTag(const char *tag)                             { m_tag = tag; }
+
     inline static void flushInstructionCache(void *p1, void *p2)    { flushInstructionCache(p1, static_cast<uint8_t*>(p2) - static_cast<uint8_t*>(p1)); }
 
     HugePagesInfo hugePages() const;
+    size_t hugePagesCoverage() const;
+    Tier tier() const;
+
+    static const char *tierName(Tier tier);
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
@@ -69,6 +93,12 @@ public:
     static void flushInstructionCache(void *p, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
+    static void initPool(size_t poolSize, size_t hugePageSize);
+    static void osInit(size_t hugePageSize);
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
 
     static inline constexpr size_t align(size_t pos, size_t align = kDefaultHugePageSize)   { return ((pos - 1) / align + 1) * align; }
     static inline size_t alignToHugePageSize(size_t pos)                                    { return align(pos, hugePageSize()); }
@@ -80,20 +110,28 @@ private:
         FLAG_1GB_PAGES,
         FLAG_LOCK,
         FLAG_EXTERNAL,
+        FLAG_THP,
         FLAG_MAX
     };
 
-    static void osInit(size_t hugePageSize);
+    static size_t coverage(const void *p, size_t size, uint64_t required);
+    static void addExecutable(void *p, size_t size);
+    static void removeExecutable(void *p);
 
     bool allocateLargePagesMemory();
     bool allocateOneGbPagesMemory();
+    bool allocateTransparentHugePagesMemory();
+    void allocate(size_t size, bool hugePages, bool oneGbPages, bool usePool, size_t alignSize);
     void freeLargePagesMemory();
 
     static size_t m_hugePageSize;
 
     const size_t m_size;
     const uint32_t m_node;
+    const char *m_tag = "memory";
     size_t m_capacity;
+    mutable size_t m_coverage = 0;
+    mutable uint64_t m_generation = 0;
     std::bitset<FLAG_MAX> m_flags;
     uint8_t *m_scratchpad = nullptr;
 };
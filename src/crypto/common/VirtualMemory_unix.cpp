@@ -148,13 +148,26 @@ void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages
         mem = mmap(0, align(size), PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | hugePagesFlag(hugePageSize()), -1, 0);
     }
 
-    if (!mem) {
+    if (!mem || mem == MAP_FAILED) {
         mem = mmap(0, size, PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#       ifdef MADV_HUGEPAGE
+        // Regular pages fallback, it can still be backed by transparent huge pages
+        if (hugePages && mem != MAP_FAILED) {
+            madvise(mem, size, MADV_HUGEPAGE);
+        }
+#       endif
     }
 
 #   endif
 
-    return mem == MAP_FAILED ? nullptr : mem;
+    if (mem == MAP_FAILED) {
+        return nullptr;
+    }
+
+    addExecutable(mem, size);
+
+    return mem;
 }
 
 
@@ -198,6 +211,7 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
 {
+    removeExecutable(p);
     munmap(p, size);
 }
 
@@ -256,6 +270,58 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateTransparentHugePagesMemory()
+{
+#   if defined(XMRIG_OS_LINUX) && defined(MADV_HUGEPAGE)
+    if (!LinuxMemory::isTransparentHugePagesAvailable()) {
+        return false;
+    }
+
+    // Transparent huge pages are PMD sized, only the 2 MB aligned part of a mapping can use them
+    constexpr size_t alignment = kDefaultHugePageSize;
+    const size_t size          = m_size + alignment;
+
+    auto mem = static_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+
+    const size_t head = (alignment - (reinterpret_cast<uintptr_t>(mem) % alignment)) % alignment;
+    if (head) {
+        munmap(mem, head);
+    }
+
+    if (size - head > m_size) {
+        munmap(mem + head + m_size, size - head - m_size);
+    }
+
+    m_scratchpad = mem + head;
+
+    if (madvise(m_scratchpad, m_size, MADV_HUGEPAGE) != 0) {
+        munmap(m_scratchpad, m_size);
+        m_scratchpad = nullptr;
+
+        return false;
+    }
+
+    // Fault in every huge page now, so the coverage check right after allocation sees the final state
+    for (size_t i = 0; i < m_size; i += alignment) {
+        m_scratchpad[i] = 0;
+    }
+
+    m_flags.set(FLAG_THP, true);
+
+    if (mlock(m_scratchpad, m_size) == 0) {
+        m_flags.set(FLAG_LOCK, true);
+    }
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     if (m_flags.test(FLAG_LOCK)) {
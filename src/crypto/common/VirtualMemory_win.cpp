@@ -198,6 +198,8 @@ void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages
         result = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, SECURE_PAGE_EXECUTE_READWRITE);
     }
 
+    addExecutable(result, size);
+
     return result;
 }
 
@@ -229,6 +231,7 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
+    removeExecutable(p);
     VirtualFree(p, 0, MEM_RELEASE);
 }
 
@@ -260,6 +263,12 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateTransparentHugePagesMemory()
+{
+    return false;
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     freeLargePagesMemory(m_scratchpad, m_size);
@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GR_CORE_HASH_AES_H
+#define XMRIG_GR_CORE_HASH_AES_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+// ECHO-512 and SHAvite-3-512 on top of AES instructions, both need a single compression for messages up to this size.
+constexpr size_t kAesCoreHashMaxSize = 109;
+
+
+// Hash "count" independent messages of the same size: message i is read from data + i * size, its 64-byte digest
+// is written to output + i * 64 (in-place with size == 64 is allowed). Longer messages fall back to sph_* code.
+void echo512_aesni(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+void shavite512_aesni(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+
+#ifdef XMRIG_VAES
+void echo512_vaes(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+void shavite512_vaes(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+#endif
+
+#ifdef XMRIG_VAES512
+void echo512_vaes512(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+void shavite512_vaes512(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+#endif
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_GR_CORE_HASH_AES_H
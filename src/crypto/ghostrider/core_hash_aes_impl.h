@@ -0,0 +1,244 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GR_CORE_HASH_AES_IMPL_H
+#define XMRIG_GR_CORE_HASH_AES_IMPL_H
+
+
+#include "core_hash_aes.h"
+
+
+#include <cstring>
+
+
+// Included by every core_hash_*.cpp after it defines struct V: one V::T register holds the same 128-bit word of
+// V::LANES independent messages, every operation used here works within 128-bit lanes, so the code below is
+// the same for AES-NI (1 message), VAES (2 messages) and VAES-512 (4 messages).
+//
+// Required V members: T, LANES, zero(), set1(), set(), load(), store(), xor_(), and_(), add(), shl<>(), shr<>(),
+// aesenc(), rot() (words 1,2,3,0) and rot2() (words 1,2,3 of the first argument, word 0 of the second).
+
+
+namespace {
+
+
+using T = V::T;
+
+
+static inline void pad_block(uint8_t* block, const uint8_t* data, size_t size)
+{
+    memcpy(block, data, size);
+    block[size] = 0x80;
+    memset(block + size + 1, 0, 128 - size - 1);
+}
+
+
+// x * 2 in GF(2^8) for every byte, 32-bit shifts only so it doesn't need AVX512BW
+static inline T mul2(T x)
+{
+    const T hi = V::and_(V::shr<7>(x), V::set1(0x01010101));
+    const T lo = V::shl<1>(V::and_(x, V::set1(0x7F7F7F7F)));
+
+    return V::xor_(V::xor_(lo, hi), V::xor_(V::xor_(V::shl<1>(hi), V::shl<3>(hi)), V::shl<4>(hi)));
+}
+
+
+static inline void echo_mix_column(T* W, int a, int b, int c, int d)
+{
+    const T ab = V::xor_(W[a], W[b]);
+    const T bc = V::xor_(W[b], W[c]);
+    const T cd = V::xor_(W[c], W[d]);
+
+    const T abx = mul2(ab);
+    const T bcx = mul2(bc);
+    const T cdx = mul2(cd);
+
+    const T A = W[a];
+    const T C = W[c];
+    const T D = W[d];
+
+    W[a] = V::xor_(V::xor_(abx, bc), D);
+    W[b] = V::xor_(V::xor_(bcx, A), cd);
+    W[c] = V::xor_(V::xor_(cdx, ab), D);
+    W[d] = V::xor_(V::xor_(V::xor_(abx, bcx), V::xor_(cdx, ab)), C);
+}
+
+
+static void echo512_lanes(const uint8_t* data, size_t size, uint8_t* output)
+{
+    alignas(64) uint8_t block[V::LANES][128];
+    for (size_t i = 0; i < V::LANES; ++i) {
+        pad_block(block[i], data + i * size, size);
+
+        // Output size in bits and the message length counter
+        block[i][110] = 0x00;
+        block[i][111] = 0x02;
+        const uint32_t bits = static_cast<uint32_t>(size << 3);
+        memcpy(block[i] + 112, &bits, sizeof(bits));
+    }
+
+    const T iv = V::set(512, 0, 0, 0);
+
+    T W[16];
+    T M[8];
+    for (size_t i = 0; i < 8; ++i) {
+        W[i] = iv;
+        M[i] = V::load(block[0] + i * 16, sizeof(block[0]));
+        W[i + 8] = M[i];
+    }
+
+    const T zero = V::zero();
+    const T one  = V::set(1, 0, 0, 0);
+    T K          = V::set(static_cast<uint32_t>(size << 3), 0, 0, 0);
+
+    for (int r = 0; r < 10; ++r) {
+        // BIG.SubWords
+        for (int n = 0; n < 16; ++n) {
+            W[n] = V::aesenc(V::aesenc(W[n], K), zero);
+            K = V::add(K, one);
+        }
+
+        // BIG.ShiftRows
+        T t = W[1];
+        W[1]  = W[5];
+        W[5]  = W[9];
+        W[9]  = W[13];
+        W[13] = t;
+
+        t = W[2];
+        W[2]  = W[10];
+        W[10] = t;
+        t = W[6];
+        W[6]  = W[14];
+        W[14] = t;
+
+        t = W[15];
+        W[15] = W[11];
+        W[11] = W[7];
+        W[7]  = W[3];
+        W[3]  = t;
+
+        // BIG.MixColumns
+        echo_mix_column(W,  0,  1,  2,  3);
+        echo_mix_column(W,  4,  5,  6,  7);
+        echo_mix_column(W,  8,  9, 10, 11);
+        echo_mix_column(W, 12, 13, 14, 15);
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        V::store(output + i * 16, 64, V::xor_(V::xor_(iv, M[i]), V::xor_(W[i], W[i + 8])));
+    }
+}
+
+
+static void shavite512_lanes(const uint8_t* data, size_t size, uint8_t* output)
+{
+    alignas(64) uint8_t block[V::LANES][128];
+    for (size_t i = 0; i < V::LANES; ++i) {
+        pad_block(block[i], data + i * size, size);
+
+        // Message length counter and output size in bits
+        const uint32_t bits = static_cast<uint32_t>(size << 3);
+        memcpy(block[i] + 110, &bits, sizeof(bits));
+        block[i][126] = 0x00;
+        block[i][127] = 0x02;
+    }
+
+    const uint32_t c0 = static_cast<uint32_t>(size << 3);
+    const T zero = V::zero();
+
+    // Key schedule, 448 32-bit words
+    T rk[112];
+    for (size_t i = 0; i < 8; ++i) {
+        rk[i] = V::load(block[0] + i * 16, sizeof(block[0]));
+    }
+
+    for (size_t v = 8;;) {
+        for (int s = 0; s < 4; ++s) {
+            rk[v] = V::xor_(V::aesenc(V::rot(rk[v - 8]), zero), rk[v - 1]);
+            if (v == 8) {
+                rk[v] = V::xor_(rk[v], V::set(c0, 0, 0, 0xFFFFFFFFU));
+            }
+            else if (v == 110) {
+                rk[v] = V::xor_(rk[v], V::set(0, c0, 0, 0xFFFFFFFFU));
+            }
+            ++v;
+
+            rk[v] = V::xor_(V::aesenc(V::rot(rk[v - 8]), zero), rk[v - 1]);
+            if (v == 41) {
+                rk[v] = V::xor_(rk[v], V::set(0, 0, 0, ~c0));
+            }
+            else if (v == 79) {
+                rk[v] = V::xor_(rk[v], V::set(0, 0, c0, 0xFFFFFFFFU));
+            }
+            ++v;
+        }
+
+        if (v == 112) {
+            break;
+        }
+
+        for (int s = 0; s < 8; ++s, ++v) {
+            rk[v] = V::xor_(rk[v - 8], V::rot2(rk[v - 2], rk[v - 1]));
+        }
+    }
+
+    const T iv[4] = {
+        V::set(0x72FCCDD8, 0x79CA4727, 0x128A077B, 0x40D55AEC),
+        V::set(0xD1901A06, 0x430AE307, 0xB29F5CD1, 0xDF07FBFC),
+        V::set(0x8E45D73D, 0x681AB538, 0xBDE86578, 0xDD577E47),
+        V::set(0xE275EADE, 0x502D9FCD, 0xB9357178, 0x022A4B9A)
+    };
+
+    T p0 = iv[0];
+    T p1 = iv[1];
+    T p2 = iv[2];
+    T p3 = iv[3];
+
+    const T* k = rk;
+    for (int r = 0; r < 14; ++r, k += 8) {
+        T x = V::xor_(p1, k[0]);
+        x = V::aesenc(x, k[1]);
+        x = V::aesenc(x, k[2]);
+        x = V::aesenc(x, k[3]);
+        p0 = V::xor_(p0, V::aesenc(x, zero));
+
+        x = V::xor_(p3, k[4]);
+        x = V::aesenc(x, k[5]);
+        x = V::aesenc(x, k[6]);
+        x = V::aesenc(x, k[7]);
+        p2 = V::xor_(p2, V::aesenc(x, zero));
+
+        const T t = p3;
+        p3 = p2;
+        p2 = p1;
+        p1 = p0;
+        p0 = t;
+    }
+
+    V::store(output +  0, 64, V::xor_(iv[0], p0));
+    V::store(output + 16, 64, V::xor_(iv[1], p1));
+    V::store(output + 32, 64, V::xor_(iv[2], p2));
+    V::store(output + 48, 64, V::xor_(iv[3], p3));
+}
+
+
+} // namespace
+
+
+#endif // XMRIG_GR_CORE_HASH_AES_IMPL_H
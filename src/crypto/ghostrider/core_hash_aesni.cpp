@@ -0,0 +1,98 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core_hash_aes.h"
+#include "sph_echo.h"
+#include "sph_shavite.h"
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+
+namespace {
+
+
+struct V
+{
+    using T = __m128i;
+
+    enum : size_t { LANES = 1 };
+
+    static inline T zero()                                                  { return _mm_setzero_si128(); }
+    static inline T set1(uint32_t a)                                        { return _mm_set1_epi32(static_cast<int>(a)); }
+    static inline T set(uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) { return _mm_setr_epi32(static_cast<int>(a0), static_cast<int>(a1), static_cast<int>(a2), static_cast<int>(a3)); }
+    static inline T load(const uint8_t* p, size_t)                          { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static inline void store(uint8_t* p, size_t, T x)                       { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static inline T xor_(T a, T b)                                          { return _mm_xor_si128(a, b); }
+    static inline T and_(T a, T b)                                          { return _mm_and_si128(a, b); }
+    static inline T add(T a, T b)                                           { return _mm_add_epi32(a, b); }
+    static inline T aesenc(T x, T key)                                      { return _mm_aesenc_si128(x, key); }
+    static inline T rot(T x)                                                { return _mm_shuffle_epi32(x, 0x39); }
+    static inline T rot2(T a, T b)                                          { return _mm_or_si128(_mm_srli_si128(a, 4), _mm_slli_si128(b, 12)); }
+
+    template<int N> static inline T shl(T x)                                { return _mm_slli_epi32(x, N); }
+    template<int N> static inline T shr(T x)                                { return _mm_srli_epi32(x, N); }
+};
+
+
+} // namespace
+
+
+#include "core_hash_aes_impl.h"
+
+
+void xmrig::ghostrider::echo512_aesni(const uint8_t* data, size_t size, uint8_t* output, size_t count)
+{
+    if (size > kAesCoreHashMaxSize) {
+        for (size_t i = 0; i < count; ++i) {
+            sph_echo512_context ctx;
+            sph_echo512_init(&ctx);
+            sph_echo512(&ctx, data + i * size, size);
+            sph_echo512_close(&ctx, output + i * 64);
+        }
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        echo512_lanes(data + i * size, size, output + i * 64);
+    }
+}
+
+
+void xmrig::ghostrider::shavite512_aesni(const uint8_t* data, size_t size, uint8_t* output, size_t count)
+{
+    if (size > kAesCoreHashMaxSize) {
+        for (size_t i = 0; i < count; ++i) {
+            sph_shavite512_context ctx;
+            sph_shavite512_init(&ctx);
+            sph_shavite512(&ctx, data + i * size, size);
+            sph_shavite512_close(&ctx, output + i * 64);
+        }
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        shavite512_lanes(data + i * size, size, output + i * 64);
+    }
+}
@@ -0,0 +1,102 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core_hash_aes.h"
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+
+namespace {
+
+
+struct V
+{
+    using T = __m256i;
+
+    enum : size_t { LANES = 2 };
+
+    static inline T zero()                                                  { return _mm256_setzero_si256(); }
+    static inline T set1(uint32_t a)                                        { return _mm256_set1_epi32(static_cast<int>(a)); }
+    static inline T set(uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) { return _mm256_broadcastsi128_si256(_mm_setr_epi32(static_cast<int>(a0), static_cast<int>(a1), static_cast<int>(a2), static_cast<int>(a3))); }
+    static inline T xor_(T a, T b)                                          { return _mm256_xor_si256(a, b); }
+    static inline T and_(T a, T b)                                          { return _mm256_and_si256(a, b); }
+    static inline T add(T a, T b)                                           { return _mm256_add_epi32(a, b); }
+    static inline T aesenc(T x, T key)                                      { return _mm256_aesenc_epi128(x, key); }
+    static inline T rot(T x)                                                { return _mm256_shuffle_epi32(x, 0x39); }
+    static inline T rot2(T a, T b)                                          { return _mm256_blend_epi32(rot(a), rot(b), 0x88); }
+
+    template<int N> static inline T shl(T x)                                { return _mm256_slli_epi32(x, N); }
+    template<int N> static inline T shr(T x)                                { return _mm256_srli_epi32(x, N); }
+
+    static inline T load(const uint8_t* p, size_t stride)
+    {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + stride));
+
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    static inline void store(uint8_t* p, size_t stride, T x)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + stride), _mm256_extracti128_si256(x, 1));
+    }
+};
+
+
+} // namespace
+
+
+#include "core_hash_aes_impl.h"
+
+
+void xmrig::ghostrider::echo512_vaes(const uint8_t* data, size_t size, uint8_t* output, size_t count)
+{
+    size_t i = 0;
+
+    if (size <= kAesCoreHashMaxSize) {
+        for (; i + V::LANES <= count; i += V::LANES) {
+            echo512_lanes(data + i * size, size, output + i * 64);
+        }
+    }
+
+    if (i < count) {
+        echo512_aesni(data + i * size, size, output + i * 64, count - i);
+    }
+}
+
+
+void xmrig::ghostrider::shavite512_vaes(const uint8_t* data, size_t size, uint8_t* output, size_t count)
+{
+    size_t i = 0;
+
+    if (size <= kAesCoreHashMaxSize) {
+        for (; i + V::LANES <= count; i += V::LANES) {
+            shavite512_lanes(data + i * size, size, output + i * 64);
+        }
+    }
+
+    if (i < count) {
+        shavite512_aesni(data + i * size, size, output + i * 64, count - i);
+    }
+}
@@ -42,11 +42,25 @@
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/common/portable/mm_malloc.h"
 
-#include <thread>
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
 #include <uv.h>
 
+#ifndef XMRIG_ARM
+#include "core_hash_aes.h"
+#endif
+
+#ifdef XMRIG_FEATURE_API
+#include "3rdparty/rapidjson/document.h"
+#endif
+
 #ifdef XMRIG_FEATURE_HWLOC
 #include "base/kernel/Platform.h"
 #include "backend/cpu/platform/HwlocCpuInfo.h"
@@ -61,12 +75,14 @@
 #   include <intrin.h>
 #endif
 
-#define CORE_HASH(i, x) static void h##i(const uint8_t* data, size_t size, uint8_t* output) \
+#define CORE_HASH(i, x) static void h##i(const uint8_t* data, size_t size, uint8_t* output, size_t count) \
 { \
-    sph_##x##_context ctx; \
-    sph_##x##_init(&ctx); \
-    sph_##x(&ctx, data, size); \
-    sph_##x##_close(&ctx, output); \
+    for (size_t j = 0; j < count; ++j) { \
+        sph_##x##_context ctx; \
+        sph_##x##_init(&ctx); \
+        sph_##x(&ctx, data + j * size, size); \
+        sph_##x##_close(&ctx, output + j * 64); \
+    } \
 }
 
 CORE_HASH( 0, blake512   );
@@ -87,8 +103,13 @@ CORE_HASH(14, whirlpool  );
 
 #undef CORE_HASH
 
-typedef void (*core_hash_func)(const uint8_t* data, size_t size, uint8_t* output);
-static const core_hash_func core_hash[15] = { h0, h1, h2, h3, h4, h5, h6, h7, h8, h9, h10, h11, h12, h13, h14 };
+// Hashes "count" inputs of the same size stored at data + i * size, outputs are stored at output + i * 64
+typedef void (*core_hash_func)(const uint8_t* data, size_t size, uint8_t* output, size_t count);
+
+static const char* core_hash_names[15] = {
+    "blake512", "bmw512", "groestl512", "jh512", "keccak512", "skein512", "luffa512", "cubehash512",
+    "shavite512", "simd512", "echo512", "hamsi512", "fugue512", "shabal512", "whirlpool"
+};
 
 namespace xmrig
 {
@@ -153,6 +174,175 @@ namespace ghostrider
 {
 
 
+// SIMD replacements for the sph_* core hashes are picked once, on first use
+struct CoreHashTable
+{
+    CoreHashTable()
+    {
+        static const core_hash_func sph[15] = { h0, h1, h2, h3, h4, h5, h6, h7, h8, h9, h10, h11, h12, h13, h14 };
+
+        for (size_t i = 0; i < 15; ++i) {
+            fn[i]   = sph[i];
+            impl[i] = "sph";
+        }
+
+#       ifndef XMRIG_ARM
+        if (Cpu::info()->hasAES()) {
+            set(8,  shavite512_aesni,   10, echo512_aesni,   "aes-ni");
+        }
+
+#       ifdef XMRIG_VAES
+        if (Cpu::info()->hasVAES()) {
+            set(8,  shavite512_vaes,    10, echo512_vaes,    "vaes");
+        }
+#       endif
+
+#       ifdef XMRIG_VAES512
+        if (Cpu::info()->hasVAES() && Cpu::info()->has(ICpuInfo::FLAG_AVX512F)) {
+            set(8,  shavite512_vaes512, 10, echo512_vaes512, "vaes-512");
+        }
+#       endif
+#       endif
+    }
+
+    inline void set(size_t i, core_hash_func f, size_t j, core_hash_func g, const char* name)
+    {
+        fn[i]   = f;
+        fn[j]   = g;
+        impl[i] = name;
+        impl[j] = name;
+    }
+
+    core_hash_func fn[15];
+    const char* impl[15];
+};
+
+
+static const CoreHashTable& core_hashes()
+{
+    static const CoreHashTable table;
+    return table;
+}
+
+
+// Counters of one thread, only that thread writes them so the hot path never touches a cache line of another thread
+struct alignas(64) CoreHashStats
+{
+    std::atomic<uint64_t> cycles[15];
+    std::atomic<uint64_t> hashes[15];
+};
+
+
+// Blocks of finished threads keep their counts and are reused by new threads, toJSON() sums all of them.
+// Constructed on first use and never destroyed, thread exit may come after static destruction.
+struct CoreHashStatsRegistry
+{
+    std::mutex mutex;
+    std::vector<CoreHashStats*> all;
+    std::vector<CoreHashStats*> free;
+};
+
+
+static CoreHashStatsRegistry& core_hash_stats_registry()
+{
+    static auto* registry = new CoreHashStatsRegistry();
+    return *registry;
+}
+
+
+struct CoreHashStatsSlot
+{
+    CoreHashStatsSlot()
+    {
+        CoreHashStatsRegistry& registry = core_hash_stats_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        if (!registry.free.empty()) {
+            stats = registry.free.back();
+            registry.free.pop_back();
+            return;
+        }
+
+        stats = new (_mm_malloc(sizeof(CoreHashStats), 64)) CoreHashStats();
+        registry.all.push_back(stats);
+    }
+
+    ~CoreHashStatsSlot()
+    {
+        CoreHashStatsRegistry& registry = core_hash_stats_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        registry.free.push_back(stats);
+    }
+
+    CoreHashStats* stats = nullptr;
+};
+
+
+static thread_local CoreHashStatsSlot core_hash_stats;
+
+
+static inline uint64_t core_hash_timestamp()
+{
+#   ifdef XMRIG_ARM
+    // No portable user mode cycle counter, use nanoseconds instead
+    return static_cast<uint64_t>(Chrono::highResolutionMSecs() * 1e6);
+#   else
+    return __rdtsc();
+#   endif
+}
+
+
+static void core_hash_run(uint32_t index, const uint8_t* data, size_t size, uint8_t* output, size_t count)
+{
+    CoreHashStats* stats = core_hash_stats.stats;
+    const uint64_t t = core_hash_timestamp();
+
+    core_hashes().fn[index](data, size, output, count);
+
+    stats->cycles[index].store(stats->cycles[index].load(std::memory_order_relaxed) + core_hash_timestamp() - t, std::memory_order_relaxed);
+    stats->hashes[index].store(stats->hashes[index].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    uint64_t cycles[15] = {};
+    uint64_t hashes[15] = {};
+
+    {
+        CoreHashStatsRegistry& registry = core_hash_stats_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (const CoreHashStats* stats : registry.all) {
+            for (size_t i = 0; i < 15; ++i) {
+                cycles[i] += stats->cycles[i].load(std::memory_order_relaxed);
+                hashes[i] += stats->hashes[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Value out(kArrayType);
+
+    for (size_t i = 0; i < 15; ++i) {
+        Value item(kObjectType);
+        item.AddMember("name",      StringRef(core_hash_names[i]), allocator);
+        item.AddMember("impl",      StringRef(core_hashes().impl[i]), allocator);
+        item.AddMember("hashes",    hashes[i], allocator);
+        item.AddMember("cycles",    hashes[i] ? (cycles[i] / hashes[i]) : 0, allocator);
+
+        out.PushBack(item, allocator);
+    }
+
+    return out;
+}
+#endif
+
+
 #ifdef XMRIG_FEATURE_HWLOC
 
 
@@ -329,6 +519,22 @@ void benchmark()
         uint8_t buf[80];
         uint8_t hash[32 * 8];
 
+        LOG_VERBOSE("%24s | Impl     | Cycles/hash", "Core hash");
+        LOG_VERBOSE("-------------------------|----------|-------------");
+
+        uint8_t core_buf[64 * 8] = {};
+
+        for (uint32_t i = 0; i < 15; ++i) {
+            uint64_t min_dt = std::numeric_limits<uint64_t>::max();
+            for (uint32_t iter = 0; iter < 16; ++iter) {
+                const uint64_t t = core_hash_timestamp();
+                core_hashes().fn[i](core_buf, 64, core_buf, 8);
+                min_dt = std::min(min_dt, core_hash_timestamp() - t);
+            }
+
+            LOG_VERBOSE("%24s | %-8s | %" PRIu64, core_hash_names[i], core_hashes().impl[i], min_dt / 8);
+        }
+
         LOG_VERBOSE("%24s |  N  | Hashrate", "Algorithm");
         LOG_VERBOSE("-------------------------|-----|-------------");
 
@@ -600,9 +806,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
                 }
 
                 for (size_t i = 0; i < 5; ++i) {
-                    for (size_t j = n; j < N; ++j) {
-                        core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                    }
+                    core_hash_run(core_indices[part * 5 + i], input + n * input_size, input_size, tmp + n * 64, N - n);
                     input = tmp;
                     input_size = 64;
                 }
@@ -644,9 +848,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             }
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                }
+                core_hash_run(core_indices[part * 5 + i], input, input_size, tmp, n);
                 input = tmp;
                 input_size = 64;
             }
@@ -712,9 +914,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
                     size_t input_size = size;
 
                     for (size_t i = 0; i < 5; ++i) {
-                        for (size_t j = n; j < N; ++j) {
-                            core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                        }
+                        core_hash_run(core_indices[part * 5 + i], input + n * input_size, input_size, tmp + n * 64, N - n);
                         input = tmp;
                         input_size = 64;
                     }
@@ -732,9 +932,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             }
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-                }
+                core_hash_run(core_indices[part * 5 + i], data, size, tmp, n);
                 data = tmp;
                 size = 64;
             }
@@ -810,11 +1008,9 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 
     for (uint64_t part = 0; part < 3; ++part) {
         for (uint64_t i = 0; i < 5; ++i) {
-            for (uint64_t j = 0; j < N; ++j) {
-                core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-                data = tmp;
-                size = 64;
-            }
+            core_hash_run(core_indices[part * 5 + i], data, size, tmp, N);
+            data = tmp;
+            size = 64;
         }
         for (uint64_t j = 0, k = step[cn_indices[part]]; j < N; j += k) {
             f[part](tmp + j * 64, 64, output + j * 32, ctx, 0);
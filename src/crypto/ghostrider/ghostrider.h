@@ -25,6 +25,11 @@
 #include <vector>
 
 
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/fwd.h"
+#endif
+
+
 struct cryptonight_ctx;
 
 
@@ -43,6 +48,11 @@ HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::v
 void destroy_helper_thread(HelperThread* t);
 void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
 
+#ifdef XMRIG_FEATURE_API
+// Implementation, hash count and average cycles per hash of every core hash since start
+rapidjson::Value toJSON(rapidjson::Document &doc);
+#endif
+
 
 } // namespace ghostrider
 
@@ -19,6 +19,11 @@
 
 #include <cinttypes>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <set>
 #include <thread>
 
 #include "crypto/kawpow/KPCache.h"
@@ -27,15 +32,95 @@
 #include "3rdparty/libethash/ethash.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/kawpow/KPHash.h"
+#include "crypto/kawpow/KPHash_test.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/document.h"
+#endif
 
 
 namespace xmrig {
 
 
-std::mutex KPCache::s_cacheMutex;
-KPCache KPCache::s_cache;
+// The mutex only guards the snapshot pointers, hashing runs on the snapshots without any lock.
+static std::mutex cacheMutex;
+static std::condition_variable cacheCv;
+static std::shared_ptr<const KPCache> current;
+static std::shared_ptr<const KPCache> next;
+static std::set<uint32_t> building;
+static std::thread builder;
+static std::thread tester;
+static bool preparing = false;
+static bool released  = false;
+static std::atomic<int> selfTestResult{-1};
+
+
+static struct {
+    std::atomic<uint64_t> buildTime{0};
+    std::atomic<uint64_t> prepareTime{0};
+    std::atomic<uint32_t> builds{0};
+    std::atomic<uint32_t> prepared{0};
+    std::atomic<uint64_t> hashes{0};
+    std::atomic<uint64_t> verifyTime{0};
+} metrics;
+
+
+static std::shared_ptr<const KPCache> build(uint32_t epoch, uint32_t threads)
+{
+    auto cache = std::make_shared<KPCache>();
+
+    return cache->init(epoch, threads) ? cache : nullptr;
+}
+
+
+// Runs the reference vector once on an idle priority thread, the first verification waits only for its result.
+// Must be called with cacheMutex held.
+static void startSelfTest()
+{
+    if (released || tester.joinable() || selfTestResult >= 0) {
+        return;
+    }
+
+    tester = std::thread([]() {
+        Platform::setThreadPriority(0);
+
+        // The vector is from epoch 0, its snapshot is built aside so the shared current/next snapshots are not replaced
+        const uint32_t epoch = kawpow_test_height / KPHash::EPOCH_LENGTH;
+        std::shared_ptr<const KPCache> cache;
+
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            if (current && current->epoch() == epoch) {
+                cache = current;
+            }
+        }
+
+        if (!cache) {
+            cache = build(epoch, 1);
+        }
+
+        uint32_t output[8]   = {};
+        uint32_t mix_hash[8] = {};
+
+        if (cache) {
+            KPHash::calculate(*cache, kawpow_test_height, kawpow_test_header, kawpow_test_nonce, output, mix_hash);
+        }
+
+        const bool ok = cache && memcmp(output, kawpow_test_out, sizeof(output)) == 0 && memcmp(mix_hash, kawpow_test_mix, sizeof(mix_hash)) == 0;
+        if (!ok) {
+            LOG_ERR("%s " RED_BOLD("KawPow self-test failed, results can't be verified"), Tags::miner());
+        }
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        selfTestResult = ok ? 1 : 0;
+        cacheCv.notify_all();
+    });
+}
 
 
 KPCache::KPCache()
@@ -49,7 +134,7 @@ KPCache::~KPCache()
 }
 
 
-bool KPCache::init(uint32_t epoch)
+bool KPCache::init(uint32_t epoch, uint32_t threads)
 {
     if (epoch >= sizeof(cache_sizes) / sizeof(cache_sizes[0])) {
         return false;
@@ -65,6 +150,7 @@ bool KPCache::init(uint32_t epoch)
     if (!m_memory || m_memory->size() < size) {
         delete m_memory;
         m_memory = new VirtualMemory(size, false, false, false);
+        m_memory->setTag("kawpow-cache");
     }
 
     const ethash_h256_t seedhash = ethash_get_seedhash(epoch);
@@ -82,7 +168,7 @@ bool KPCache::init(uint32_t epoch)
 
     // Init DAG cache
     {
-        const uint64_t n = std::max(std::thread::hardware_concurrency(), 1U);
+        const uint64_t n = threads ? threads : std::max(std::thread::hardware_concurrency(), 1U);
 
         std::vector<std::thread> threads;
         threads.reserve(n);
@@ -112,6 +198,173 @@ bool KPCache::init(uint32_t epoch)
 }
 
 
+std::shared_ptr<const KPCache> KPCache::get(uint32_t epoch)
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+
+    while (!current || current->epoch() != epoch) {
+        if (next && next->epoch() == epoch) {
+            current = std::move(next);
+            next.reset();
+            ++metrics.prepared;
+
+            break;
+        }
+
+        if (building.count(epoch) == 0) {
+            building.insert(epoch);
+            lock.unlock();
+
+            const uint64_t ts = Chrono::steadyMSecs();
+            auto cache        = build(epoch, 0);
+
+            metrics.buildTime = Chrono::steadyMSecs() - ts;
+            ++metrics.builds;
+
+            lock.lock();
+            building.erase(epoch);
+
+            if (cache) {
+                current = std::move(cache);
+            }
+
+            cacheCv.notify_all();
+
+            return current && current->epoch() == epoch ? current : nullptr;
+        }
+
+        cacheCv.wait(lock);
+    }
+
+    return current;
+}
+
+
+void KPCache::prepare(uint64_t height)
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        startSelfTest();
+    }
+
+    if ((height % KPHash::EPOCH_LENGTH) < KPHash::EPOCH_LENGTH - prepare_blocks) {
+        return;
+    }
+
+    const uint32_t epoch = static_cast<uint32_t>(height / KPHash::EPOCH_LENGTH) + 1;
+    if (cache_size(epoch) == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    if (released || preparing || building.count(epoch) || (next && next->epoch() == epoch) || (current && current->epoch() == epoch)) {
+        return;
+    }
+
+    // The previous background build has already left the critical section
+    if (builder.joinable()) {
+        builder.join();
+    }
+
+    preparing = true;
+    building.insert(epoch);
+
+    builder = std::thread([epoch]() {
+        Platform::setThreadPriority(0);
+
+        const uint64_t ts = Chrono::steadyMSecs();
+        auto cache        = build(epoch, 1);
+
+        metrics.prepareTime = Chrono::steadyMSecs() - ts;
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        building.erase(epoch);
+        preparing = false;
+
+        if (cache) {
+            next = std::move(cache);
+        }
+
+        cacheCv.notify_all();
+    });
+}
+
+
+void KPCache::release()
+{
+    std::thread thread;
+    std::thread test;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        thread   = std::move(builder);
+        test     = std::move(tester);
+        released = true;
+    }
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    if (test.joinable()) {
+        test.join();
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    current.reset();
+    next.reset();
+}
+
+
+void KPCache::addVerified(size_t hashes, double time)
+{
+    metrics.hashes     += hashes;
+    metrics.verifyTime += static_cast<uint64_t>(time * 1000.0);
+}
+
+
+bool KPCache::selfTest()
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    startSelfTest();
+
+    cacheCv.wait(lock, []() { return selfTestResult >= 0 || !tester.joinable(); });
+
+    return selfTestResult == 1;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value KPCache::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        out.AddMember("epoch",      current ? Value(current->epoch()) : Value(kNullType), allocator);
+        out.AddMember("next_epoch", next ? Value(next->epoch()) : Value(kNullType), allocator);
+    }
+
+    const uint64_t hashes = metrics.hashes;
+
+    out.AddMember("builds",         metrics.builds.load(), allocator);
+    out.AddMember("build_time",     metrics.buildTime.load(), allocator);
+    out.AddMember("prepared",       metrics.prepared.load(), allocator);
+    out.AddMember("prepare_time",   metrics.prepareTime.load(), allocator);
+    out.AddMember("verified",       hashes, allocator);
+    out.AddMember("verify_time",    hashes ? static_cast<double>(metrics.verifyTime.load()) / hashes : 0.0, allocator);
+    out.AddMember("self_test",      selfTestResult < 0 ? Value(kNullType) : Value(selfTestResult == 1), allocator);
+
+    return out;
+}
+#endif
+
+
 void* KPCache::data() const
 {
     return m_memory ? m_memory->raw() : nullptr;
@@ -21,10 +21,15 @@
 
 
 #include "base/tools/Object.h"
-#include <mutex>
+#include <memory>
 #include <vector>
 
 
+#ifdef XMRIG_FEATURE_API
+#   include "3rdparty/rapidjson/fwd.h"
+#endif
+
+
 namespace xmrig
 {
 
@@ -38,13 +43,14 @@ public:
     static constexpr size_t l1_cache_size = 16 * 1024;
     static constexpr size_t l1_cache_num_items = l1_cache_size / sizeof(uint32_t);
     static constexpr uint32_t num_dataset_parents = 512;
+    static constexpr uint32_t prepare_blocks = 150;
 
     XMRIG_DISABLE_COPY_MOVE(KPCache)
 
     KPCache();
     ~KPCache();
 
-    bool init(uint32_t epoch);
+    bool init(uint32_t epoch, uint32_t threads = 0);
 
     void* data() const;
     size_t size() const { return m_size; }
@@ -57,8 +63,21 @@ public:
 
     static void calculate_fast_mod_data(uint32_t divisor, uint32_t &reciprocal, uint32_t &increment, uint32_t& shift);
 
-    static std::mutex s_cacheMutex;
-    static KPCache s_cache;
+    // Read-only snapshot of the cache for the epoch, shared by every caller and kept alive while in use.
+    static std::shared_ptr<const KPCache> get(uint32_t epoch);
+
+    // Starts the self-test once, builds the next epoch cache in background during the last prepare_blocks blocks of the current epoch.
+    static void prepare(uint64_t height);
+    static void release();
+
+    static void addVerified(size_t hashes, double time);
+
+    // Result of the check of KPHash::calculate against the reference vector on an epoch 0 snapshot, waits for the test to finish.
+    static bool selfTest();
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
 
 private:
     VirtualMemory* m_memory = nullptr;
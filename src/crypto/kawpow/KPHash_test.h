@@ -0,0 +1,53 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_KP_HASH_TEST_H
+#define XMRIG_KP_HASH_TEST_H
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// KawPow reference vector: block 0 (epoch 0), zero header hash and nonce 0
+const static uint32_t kawpow_test_height = 0;
+const static uint64_t kawpow_test_nonce  = 0;
+
+const static uint8_t kawpow_test_header[32] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+const static uint8_t kawpow_test_out[32] = {
+    0xE6, 0x01, 0xA7, 0x25, 0x7A, 0x70, 0xDC, 0x48, 0xFC, 0xCC, 0x97, 0xA7, 0x33, 0x0D, 0x70, 0x4D,
+    0x77, 0x60, 0x47, 0x62, 0x3B, 0x92, 0x88, 0x3D, 0x77, 0x11, 0x1F, 0xB3, 0x68, 0x70, 0xF3, 0xD1
+};
+
+const static uint8_t kawpow_test_mix[32] = {
+    0x6E, 0x97, 0xB4, 0x7B, 0x13, 0x4F, 0xDA, 0x0C, 0x78, 0x88, 0x80, 0x29, 0x88, 0xE1, 0xA3, 0x73,
+    0xAF, 0xFE, 0xB2, 0x8B, 0xCD, 0x81, 0x3B, 0x6E, 0x9A, 0x0F, 0xC6, 0x69, 0xC9, 0x35, 0xD0, 0x3A
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_KP_HASH_TEST_H */
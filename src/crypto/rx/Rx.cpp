@@ -20,6 +20,7 @@
 #include "crypto/rx/Rx.h"
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
+#include "base/kernel/Startup.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxQueue.h"
 #include "crypto/randomx/randomx.h"
@@ -31,6 +32,10 @@
 #   include "crypto/rx/RxMsr.h"
 #endif
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "crypto/rx/RxResctrl.h"
+#endif
+
 
 namespace xmrig {
 
@@ -51,6 +56,28 @@ public:
 };
 
 
+// resctrl is preferred for cache QoS, MSR writes are the fallback
+template<typename T>
+static void initCacheQoS(const T &seed, const RxConfig &config, const CpuConfig &cpu)
+{
+    Startup::begin("cache-qos");
+
+#   ifdef XMRIG_FEATURE_RESCTRL
+    if (!RxResctrl::isInitialized()) {
+        RxResctrl::init(config);
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_MSR
+    if (!RxMsr::isInitialized()) {
+        RxMsr::init(config, cpu.threads().get(seed.algorithm()).data());
+    }
+#   endif
+
+    Startup::end("cache-qos");
+}
+
+
 } // namespace xmrig
 
 
@@ -68,6 +95,10 @@ xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 
 void xmrig::Rx::destroy()
 {
+#   ifdef XMRIG_FEATURE_RESCTRL
+    RxResctrl::destroy();
+#   endif
+
 #   ifdef XMRIG_FEATURE_MSR
     RxMsr::destroy();
 #   endif
@@ -96,6 +127,10 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         && (f != Algorithm::GHOSTRIDER)
 #       endif
         ) {
+#       ifdef XMRIG_FEATURE_RESCTRL
+        RxResctrl::destroy();
+#       endif
+
 #       ifdef XMRIG_FEATURE_MSR
         RxMsr::destroy();
 #       endif
@@ -103,20 +138,18 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         return true;
     }
 
-#   ifdef XMRIG_FEATURE_MSR
-    if (!RxMsr::isInitialized()) {
-        RxMsr::init(config, cpu.threads().get(seed.algorithm()).data());
-    }
-#   endif
-
 #   ifdef XMRIG_ALGO_CN_HEAVY
     if (f == Algorithm::CN_HEAVY) {
+        initCacheQoS(seed, config, cpu);
+
         return true;
     }
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (f == Algorithm::GHOSTRIDER) {
+        initCacheQoS(seed, config, cpu);
+
         return true;
     }
 #   endif
@@ -137,11 +170,16 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     }
 
     if (isReady(seed)) {
+        initCacheQoS(seed, config, cpu);
+
         return true;
     }
 
     d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
 
+    // The dataset is already being initialized in the background, cache QoS setup overlaps with it.
+    initCacheQoS(seed, config, cpu);
+
     return false;
 }
 
@@ -36,6 +36,7 @@ static_assert(RANDOMX_FLAG_JIT == 8, "RANDOMX_FLAG_JIT flag mismatch");
 xmrig::RxCache::RxCache(bool hugePages, uint32_t nodeId)
 {
     m_memory = new VirtualMemory(maxSize(), hugePages, false, false, nodeId);
+    m_memory->setTag("cache");
 
     create(m_memory->raw());
 }
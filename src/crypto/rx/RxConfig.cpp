@@ -29,7 +29,9 @@
 
 #include <array>
 #include <algorithm>
+#include <cinttypes>
 #include <cmath>
+#include <cstdio>
 
 
 #ifdef _MSC_VER
@@ -43,11 +45,14 @@ const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
 const char *RxConfig::kField                    = "randomx";
 const char *RxConfig::kMode                     = "mode";
+const char *RxConfig::kMsrExplore               = "msr-explore";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kCacheQoSL3               = "cache_qos_l3";
+const char *RxConfig::kCacheQoSMB               = "cache_qos_mb";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -89,7 +94,17 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         readMSR(Json::getValue(value, kWrmsr));
 #       endif
 
-        m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_cacheQoS   = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_cacheQoSMB = std::min(std::max(Json::getUint(value, kCacheQoSMB, m_cacheQoSMB), 10U), 100U);
+
+        const auto &l3 = Json::getValue(value, kCacheQoSL3);
+        if (l3.IsString()) {
+            m_cacheQoSL3 = strtoull(l3.GetString(), nullptr, 0);
+        }
+        else if (l3.IsUint64()) {
+            m_cacheQoSL3 = l3.GetUint64();
+        }
+        m_msrExplore = Json::getBool(value, kMsrExplore, m_msrExplore);
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
@@ -161,6 +176,19 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
 
+    if (m_cacheQoSL3) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "0x%" PRIx64, m_cacheQoSL3);
+
+        obj.AddMember(StringRef(kCacheQoSL3), Value(buf, allocator), allocator);
+    }
+    else {
+        obj.AddMember(StringRef(kCacheQoSL3), kNullType, allocator);
+    }
+
+    obj.AddMember(StringRef(kCacheQoSMB), m_cacheQoSMB, allocator);
+    obj.AddMember(StringRef(kMsrExplore), m_msrExplore, allocator);
+
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
         Value numa(kArrayType);
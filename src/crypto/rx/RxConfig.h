@@ -53,10 +53,13 @@ public:
     };
 
     static const char *kCacheQoS;
+    static const char *kCacheQoSL3;
+    static const char *kCacheQoSMB;
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
     static const char *kMode;
+    static const char *kMsrExplore;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
@@ -83,6 +86,9 @@ public:
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
+    inline uint32_t cacheQoSMB() const  { return m_cacheQoSMB; }
+    inline uint64_t cacheQoSL3() const  { return m_cacheQoSL3; }
+    inline bool isMsrExplore() const    { return m_msrExplore; }
     inline Mode mode() const            { return m_mode; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
@@ -104,6 +110,9 @@ private:
 #   endif
 
     bool m_cacheQoS = false;
+    bool m_msrExplore = false;
+    uint32_t m_cacheQoSMB = 100;
+    uint64_t m_cacheQoSL3 = 0;
 
     static Mode readMode(const rapidjson::Value &value);
 
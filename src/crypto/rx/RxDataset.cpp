@@ -210,6 +210,7 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
     }
 
     m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node);
+    m_memory->setTag("dataset");
 
     if (m_memory->isOneGbPages()) {
         m_scratchpadOffset = maxSize() + RANDOMX_CACHE_MAX_SIZE;
@@ -27,6 +27,11 @@
 #include "hw/msr/Msr.h"
 
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "crypto/rx/RxResctrl.h"
+#endif
+
+
 #include <algorithm>
 #include <set>
 
@@ -145,6 +150,10 @@ bool xmrig::RxMsr::init(const RxConfig &config, const std::vector<CpuThread> &th
     const uint64_t ts = Chrono::steadyMSecs();
     m_cacheQoS        = config.cacheQoS();
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    m_cacheQoS = m_cacheQoS && !RxResctrl::isEnabled();
+#   endif
+
     if (m_cacheQoS && !Cpu::info()->hasCatL3()) {
         LOG_WARN("%s " YELLOW_BOLD("this CPU doesn't support cat_l3, cache QoS is unavailable"), Msr::tag());
 
@@ -162,6 +171,31 @@ bool xmrig::RxMsr::init(const RxConfig &config, const std::vector<CpuThread> &th
 }
 
 
+// Remember initial values of registers which are changed after init, they are restored by destroy() as well
+bool xmrig::RxMsr::save(const MsrItems &preset)
+{
+    auto msr = Msr::get();
+    if (!msr) {
+        return false;
+    }
+
+    for (const auto &i : preset) {
+        if (std::any_of(items.begin(), items.end(), [&i](const MsrItem &item) { return item.reg() == i.reg(); })) {
+            continue;
+        }
+
+        auto item = msr->read(i.reg());
+        if (!item.isValid()) {
+            return false;
+        }
+
+        items.emplace_back(item);
+    }
+
+    return true;
+}
+
+
 void xmrig::RxMsr::destroy()
 {
     if (!isInitialized()) {
@@ -21,6 +21,9 @@
 #define XMRIG_RXMSR_H
 
 
+#include "hw/msr/MsrItem.h"
+
+
 #include <vector>
 
 
@@ -39,6 +42,7 @@ public:
     static inline bool isInitialized()  { return m_initialized; }
 
     static bool init(const RxConfig &config, const std::vector<CpuThread> &threads);
+    static bool save(const MsrItems &preset);
     static void destroy();
 
 private:
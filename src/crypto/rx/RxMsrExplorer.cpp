@@ -0,0 +1,344 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxMsrExplorer.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "crypto/rx/RxMsr.h"
+#include "hw/msr/Msr.h"
+
+
+#include <algorithm>
+
+
+namespace xmrig {
+
+
+constexpr static double kMinGain    = 0.01;
+constexpr static uint64_t kTrial    = 30000;
+constexpr static uint64_t kWarmup   = 10000;
+
+
+// Registers and bits which only control hardware prefetchers, nothing else is ever written by exploration
+struct Knob
+{
+    ICpuInfo::Vendor vendor;
+    uint32_t reg;
+    uint64_t mask;
+};
+
+
+static const Knob knobs[] = {
+    { ICpuInfo::VENDOR_INTEL,   0x1a4,      0xF         },  // MISC_FEATURE_CONTROL: L2 streamer, L2 adjacent line, DCU streamer, DCU IP
+    { ICpuInfo::VENDOR_AMD,     0xC0011022, 1ULL << 13  },  // DC_CFG: hardware prefetcher disable
+    { ICpuInfo::VENDOR_AMD,     0xC0000108, 0x2F        },  // PrefetchControl: L1 stream, stride, region, L2 stream, up/down
+};
+
+
+#ifdef XMRIG_OS_WIN
+static constexpr inline int32_t get_cpu(int32_t)        { return -1; }
+#else
+static constexpr inline int32_t get_cpu(int32_t cpu)    { return cpu; }
+#endif
+
+
+static bool apply(const MsrItems &original, const MsrItems &items)
+{
+    auto msr = Msr::get();
+    if (!msr) {
+        return false;
+    }
+
+    return msr->write([&msr, &original, &items](int32_t cpu) {
+        for (const auto &item : original) {
+            if (!msr->write(item, get_cpu(cpu), false)) {
+                return false;
+            }
+        }
+
+        for (const auto &item : items) {
+            if (!msr->write(item, get_cpu(cpu), false)) {
+                return false;
+            }
+        }
+
+        return true;
+    });
+}
+
+
+static String toString(const MsrItems &items)
+{
+    std::string out;
+
+    for (const auto &item : items) {
+        out += (out.empty() ? "\"" : ", \"") + std::string(item.toString().data()) + "\"";
+    }
+
+    return out.c_str();
+}
+
+
+} // namespace xmrig
+
+
+xmrig::RxMsrExplorer::RxMsrExplorer(const MsrItems &preset) :
+    m_preset(preset)
+{
+}
+
+
+xmrig::RxMsrExplorer::~RxMsrExplorer()
+{
+    // RxMsr::destroy() restores the initial values itself when RandomX is no longer used
+    if (m_state == RUNNING && RxMsr::isInitialized()) {
+        apply(m_original, {});
+    }
+}
+
+
+void xmrig::RxMsrExplorer::tick(const Hashrate *hashrate, uint64_t now)
+{
+    if (m_state == DONE || !hashrate || !RxMsr::isInitialized()) {
+        return;
+    }
+
+    // Dataset is not ready yet or mining is paused, the trial starts again
+    if (hashrate->calc(Hashrate::ShortInterval) <= 0.0) {
+        m_ts = now;
+
+        return;
+    }
+
+    if (m_state == IDLE) {
+        if (!init()) {
+            m_state = DONE;
+
+            return;
+        }
+
+        m_state = RUNNING;
+        m_ts    = now;
+
+        return;
+    }
+
+    if (now - m_ts < kWarmup + kTrial) {
+        return;
+    }
+
+    Trial &trial   = m_trials[m_index];
+    trial.hashrate = hashrate->calc(kTrial);
+
+    LOG_VERBOSE("%s " MAGENTA_BOLD("explore") " %zu/%zu " CYAN_BOLD("[%s]") WHITE_BOLD(" %.1f H/s"), Msr::tag(), m_index + 1, m_trials.size(), trial.items.empty() ? "active" : toString(trial.items).data(), trial.hashrate);
+
+    if (++m_index == m_trials.size()) {
+        return finish();
+    }
+
+    // Before the final baseline, validate the best trials of different registers together
+    if (m_index == m_trials.size() - 1 && !m_combined) {
+        m_combined = true;
+
+        Trial combined;
+
+        for (const auto &original : m_original) {
+            const Trial *best = nullptr;
+
+            for (size_t i = 1; i < m_index; ++i) {
+                if (m_trials[i].items.front().reg() == original.reg() && m_trials[i].hashrate > m_trials[0].hashrate * (1.0 + kMinGain) && (!best || m_trials[i].hashrate > best->hashrate)) {
+                    best = &m_trials[i];
+                }
+            }
+
+            if (best) {
+                combined.items.emplace_back(best->items.front());
+            }
+        }
+
+        if (combined.items.size() > 1) {
+            m_trials.insert(m_trials.begin() + static_cast<ptrdiff_t>(m_index), combined);
+        }
+    }
+
+    apply(m_original, m_trials[m_index].items);
+    m_ts = now;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::RxMsrExplorer::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    static const char *states[] = { "idle", "running", "done" };
+
+    auto items = [&doc, &allocator](const MsrItems &items) {
+        Value out(kArrayType);
+        for (const auto &item : items) {
+            out.PushBack(item.toJSON(doc), allocator);
+        }
+
+        return out;
+    };
+
+    const double base = baseline();
+
+    Value trials(kArrayType);
+    for (size_t i = 0; i < m_index && i < m_trials.size(); ++i) {
+        Value obj(kObjectType);
+        obj.AddMember("wrmsr",      items(m_trials[i].items), allocator);
+        obj.AddMember("hashrate",   Json::normalize(m_trials[i].hashrate, false), allocator);
+        obj.AddMember("gain",       base > 0.0 ? Json::normalize((m_trials[i].hashrate / base - 1.0) * 100.0, true) : Value(kNullType), allocator);
+
+        trials.PushBack(obj, allocator);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("state",  StringRef(states[m_state]), allocator);
+    out.AddMember("trial",  static_cast<uint64_t>(m_index), allocator);
+    out.AddMember("total",  static_cast<uint64_t>(m_trials.size()), allocator);
+    out.AddMember("trials", trials, allocator);
+
+    if (m_state == DONE && m_best) {
+        Value best(kObjectType);
+        best.AddMember("wrmsr", items(result(m_trials[m_best])), allocator);
+        best.AddMember("gain",  Json::normalize((m_trials[m_best].hashrate / base - 1.0) * 100.0, true), allocator);
+
+        out.AddMember("best", best, allocator);
+    }
+
+    return out;
+}
+#endif
+
+
+bool xmrig::RxMsrExplorer::init()
+{
+    auto msr = Msr::get();
+    if (!msr) {
+        LOG_WARN("%s " YELLOW_BOLD("MSR exploration is unavailable without access to MSR registers"), Msr::tag());
+
+        return false;
+    }
+
+    const auto vendor = Cpu::info()->vendor();
+
+    for (const auto &knob : knobs) {
+        if (knob.vendor != vendor) {
+            continue;
+        }
+
+        const auto item = msr->read(knob.reg, -1, false);
+        if (!item.isValid()) {
+            continue;
+        }
+
+        m_original.emplace_back(item);
+
+        for (uint64_t bits = knob.mask;; bits = (bits - 1) & knob.mask) {
+            if ((item.value() & knob.mask) != bits) {
+                Trial trial;
+                trial.items.emplace_back(knob.reg, bits, knob.mask);
+
+                m_trials.emplace_back(trial);
+            }
+
+            if (bits == 0) {
+                break;
+            }
+        }
+    }
+
+    if (m_trials.empty() || !RxMsr::save(m_original)) {
+        LOG_WARN("%s " YELLOW_BOLD("MSR exploration is unavailable, no whitelisted prefetcher registers on this CPU"), Msr::tag());
+
+        return false;
+    }
+
+    m_trials.insert(m_trials.begin(), Trial());
+    m_trials.emplace_back();
+
+    LOG_INFO("%s " MAGENTA_BOLD("explore") " %zu trials of prefetcher bits, about " CYAN_BOLD("%" PRIu64) " minutes",
+             Msr::tag(),
+             m_trials.size(),
+             (m_trials.size() * (kWarmup + kTrial)) / 60000 + 1
+             );
+
+    return true;
+}
+
+
+double xmrig::RxMsrExplorer::baseline() const
+{
+    const double last = m_trials.empty() ? 0.0 : m_trials.back().hashrate;
+
+    return last > 0.0 ? (m_trials.front().hashrate + last) / 2.0 : (m_trials.empty() ? 0.0 : m_trials.front().hashrate);
+}
+
+
+// Active preset with the trial applied on top, ready to be used as "wrmsr" in the config
+xmrig::MsrItems xmrig::RxMsrExplorer::result(const Trial &trial) const
+{
+    MsrItems out = m_preset;
+
+    for (const auto &item : trial.items) {
+        auto it = std::find_if(out.begin(), out.end(), [&item](const MsrItem &i) { return i.reg() == item.reg(); });
+
+        if (it == out.end()) {
+            out.emplace_back(item);
+        }
+        else {
+            *it = MsrItem(item.reg(), MsrItem::maskedValue(it->value(), item.value(), item.mask()), it->mask() == MsrItem::kNoMask ? MsrItem::kNoMask : (it->mask() | item.mask()));
+        }
+    }
+
+    return out;
+}
+
+
+void xmrig::RxMsrExplorer::finish()
+{
+    m_state = DONE;
+    apply(m_original, {});
+
+    const double base = baseline();
+
+    for (size_t i = 1; i < m_trials.size() - 1; ++i) {
+        if (m_trials[i].hashrate > base * (1.0 + kMinGain) && (!m_best || m_trials[i].hashrate > m_trials[m_best].hashrate)) {
+            m_best = i;
+        }
+    }
+
+    if (!m_best) {
+        LOG_INFO("%s " MAGENTA_BOLD("explore") " no preset is at least " CYAN_BOLD("%.0f%%") " faster than the active one", Msr::tag(), kMinGain * 100.0);
+
+        return;
+    }
+
+    LOG_NOTICE("%s " MAGENTA_BOLD("explore") GREEN_BOLD(" best preset +%.1f%%") ", review and add to the \"randomx\" config: " CYAN_BOLD("\"wrmsr\": [%s]"),
+               Msr::tag(),
+               (m_trials[m_best].hashrate / base - 1.0) * 100.0,
+               toString(result(m_trials[m_best])).data()
+               );
+}
@@ -0,0 +1,92 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_RXMSREXPLORER_H
+#define XMRIG_RXMSREXPLORER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+#include "hw/msr/MsrItem.h"
+
+
+namespace xmrig
+{
+
+
+class Hashrate;
+
+
+/**
+ * Searches for a better MSR preset while mining RandomX.
+ *
+ * Only whitelisted prefetcher control bits are changed: every combination of the bits of one register is a trial,
+ * applied on top of the active preset and measured by the hashrate of the running threads. The best single register
+ * trials are validated together, the active state is measured before and after to cancel drift. Nothing is persisted,
+ * the original values are restored when exploration ends and the best preset is reported for review.
+ */
+class RxMsrExplorer
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxMsrExplorer)
+
+    RxMsrExplorer(const MsrItems &preset);
+    ~RxMsrExplorer();
+
+    inline bool isDone() const  { return m_state == DONE; }
+
+    void tick(const Hashrate *hashrate, uint64_t now);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    enum State : uint32_t {
+        IDLE,
+        RUNNING,
+        DONE
+    };
+
+    struct Trial
+    {
+        double hashrate = 0.0;
+        MsrItems items;
+    };
+
+    bool init();
+    double baseline() const;
+    MsrItems result(const Trial &trial) const;
+    void finish();
+
+    bool m_combined     = false;
+    const MsrItems m_preset;
+    MsrItems m_original;
+    size_t m_best       = 0;
+    size_t m_index      = 0;
+    State m_state       = IDLE;
+    std::vector<Trial> m_trials;
+    uint64_t m_ts       = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RXMSREXPLORER_H */
@@ -19,10 +19,12 @@
  */
 
 #include "crypto/rx/RxQueue.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/common/interfaces/IRxListener.h"
 #include "base/io/Async.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Startup.h"
 #include "base/tools/Cvt.h"
 #include "crypto/rx/RxBasicStorage.h"
 
@@ -32,6 +34,50 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_HTTP
+#   include "base/api/EventStream.h"
+#endif
+
+
+namespace xmrig {
+
+
+static void publish(const char *state, const RxSeed &seed, uint32_t threads)
+{
+#   ifdef XMRIG_FEATURE_HTTP
+    if (!Log::isEvents() && !EventStream::isActive()) {
+        return;
+    }
+#   else
+    if (!Log::isEvents()) {
+        return;
+    }
+#   endif
+
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("state",   StringRef(state), allocator);
+    doc.AddMember("algo",    StringRef(seed.algorithm().name()), allocator);
+    doc.AddMember("seed",    Cvt::toHex(seed.data().data(), 8).toJSON(doc), allocator);
+
+    if (threads) {
+        doc.AddMember("threads", threads, allocator);
+    }
+
+    Log::event(Log::INFO, "dataset", doc);
+
+#   ifdef XMRIG_FEATURE_HTTP
+    EventStream::publish("dataset", doc);
+#   endif
+}
+
+
+} // namespace xmrig
+
+
 xmrig::RxQueue::RxQueue(IRxListener *listener) :
     m_listener(listener)
 {
@@ -110,6 +156,9 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
     lock.unlock();
 
     m_cv.notify_one();
+
+    Startup::begin("dataset");
+    publish("init", seed, threads);
 }
 
 
@@ -166,10 +215,14 @@ void xmrig::RxQueue::onReady()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     const bool ready = m_listener && m_state == STATE_IDLE;
+    const RxSeed seed = m_seed;
     lock.unlock();
 
     if (ready) {
         m_listener->onDatasetReady();
+
+        Startup::end("dataset");
+        publish("ready", seed, 0);
     }
 }
 
@@ -0,0 +1,303 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxResctrl.h"
+#include "3rdparty/fmt/core.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "crypto/rx/RxConfig.h"
+
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <mutex>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+
+namespace xmrig {
+
+
+bool RxResctrl::m_enabled       = false;
+bool RxResctrl::m_initialized   = false;
+
+
+static const std::string kRoot  = "/sys/fs/resctrl/";
+static const std::string kGroup = kRoot + "xmrig/";
+static std::mutex mutex;
+static std::set<long> tids;
+
+
+// resctrl reports invalid input as a write error, so one line per write() call
+static bool write(const std::string &path, const std::string &data)
+{
+    const int fd = open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool result = ::write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    close(fd);
+
+    return result;
+}
+
+
+static std::string read(const std::string &path)
+{
+    std::string out;
+    char buf[256];
+
+    FILE *fp = fopen(path.c_str(), "r");
+    if (!fp) {
+        return out;
+    }
+
+    while (fgets(buf, sizeof(buf), fp)) {
+        out += buf;
+    }
+
+    fclose(fp);
+
+    return out;
+}
+
+
+// Domain ids of a schemata resource line, for example "L3:0=7ff;1=7ff"
+static std::vector<unsigned> domains(const std::string &schemata, const char *resource)
+{
+    std::vector<unsigned> out;
+    const std::string prefix = std::string(resource) + ":";
+
+    size_t pos = schemata.find(prefix);
+    if (pos == std::string::npos || (pos > 0 && schemata[pos - 1] != '\n' && schemata[pos - 1] != ' ')) {
+        return out;
+    }
+
+    pos += prefix.size();
+    const size_t end = schemata.find('\n', pos);
+
+    while (pos < end) {
+        unsigned id = 0;
+        if (sscanf(schemata.c_str() + pos, "%u=", &id) == 1) {
+            out.emplace_back(id);
+        }
+
+        pos = schemata.find(';', pos);
+        if (pos == std::string::npos || pos > end) {
+            break;
+        }
+
+        ++pos;
+    }
+
+    return out;
+}
+
+
+static std::string line(const char *resource, const std::vector<unsigned> &ids, const char *format, uint64_t value)
+{
+    std::string out = std::string(resource) + ":";
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        out += fmt::format("{}{}=", i ? ";" : "", ids[i]) + fmt::format(format, value);
+    }
+
+    return out + "\n";
+}
+
+
+static inline long gettid()
+{
+    return syscall(SYS_gettid);
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxResctrl::init(const RxConfig &config)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    m_initialized = true;
+    m_enabled     = false;
+
+    if (!config.cacheQoS() || access((kRoot + "schemata").c_str(), W_OK) != 0) {
+        return false;
+    }
+
+    // Without an explicit L3 mask the mining group would share all of L3 with the default group, the MSR
+    // implementation keeps the old behavior (other cores lose their L3 access) in that case
+    if (!config.cacheQoSL3()) {
+        if (config.cacheQoSMB() < 100) {
+            LOG_WARN("%s " YELLOW_BOLD("memory bandwidth limit requires \"cache_qos_l3\" mask, ignored"), Tags::randomx());
+        }
+
+        return false;
+    }
+
+    const std::string schemata = read(kRoot + "schemata");
+    const auto l3              = domains(schemata, "L3");
+    const auto mb              = domains(schemata, "MB");
+
+    uint64_t cbm = 0;
+    if (l3.empty() || sscanf(read(kRoot + "info/L3/cbm_mask").c_str(), "%" SCNx64, &cbm) != 1 || cbm == 0) {
+        return false;
+    }
+
+    const uint64_t mask = config.cacheQoSL3() & cbm;
+    if (mask != config.cacheQoSL3()) {
+        LOG_WARN("%s " YELLOW_BOLD("L3 mask 0x%" PRIx64 " is outside of supported 0x%" PRIx64 ", using 0x%" PRIx64), Tags::randomx(), config.cacheQoSL3(), cbm, mask);
+    }
+
+    if (mkdir(kGroup.c_str(), 0755) != 0 && errno != EEXIST) {
+        LOG_WARN("%s " YELLOW_BOLD("failed to create resctrl group \"%s\" (%s), fallback to MSR"), Tags::randomx(), kGroup.c_str(), strerror(errno));
+
+        return false;
+    }
+
+    const uint32_t bandwidth = config.cacheQoSMB();
+    bool result              = mask && write(kGroup + "schemata", line("L3", l3, "{:x}", mask));
+
+    if (result && bandwidth < 100) {
+        if (mb.empty()) {
+            LOG_WARN("%s " YELLOW_BOLD("memory bandwidth allocation is not supported"), Tags::randomx());
+        }
+        else {
+            result = write(kGroup + "schemata", line("MB", mb, "{}", bandwidth));
+        }
+    }
+
+    if (!result) {
+        std::string status = read(kRoot + "info/last_cmd_status");
+        status.erase(status.find_last_not_of('\n') + 1);
+
+        LOG_ERR("%s " RED_BOLD("failed to set resctrl schemata: %s"), Tags::randomx(), status.c_str());
+        rmdir(kGroup.c_str());
+
+        return false;
+    }
+
+    m_enabled = true;
+
+    for (long tid : tids) {
+        write(kGroup + "tasks", std::to_string(tid));
+    }
+
+    LOG_NOTICE("%s " GREEN_BOLD("cache QoS resctrl group ") WHITE_BOLD("\"xmrig\"") GREEN_BOLD(" L3 mask ") CYAN_BOLD("0x%" PRIx64) GREEN_BOLD(" memory bandwidth ") CYAN_BOLD("%u%%"),
+               Tags::randomx(), mask, mb.empty() ? 100 : bandwidth);
+
+    return true;
+}
+
+
+void xmrig::RxResctrl::destroy()
+{
+    if (!isInitialized()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    m_initialized = false;
+
+    if (m_enabled) {
+        m_enabled = false;
+
+        // Tasks of a removed group return to the default group
+        rmdir(kGroup.c_str());
+    }
+}
+
+
+void xmrig::RxResctrl::join()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const long tid = gettid();
+    tids.insert(tid);
+
+    if (m_enabled) {
+        write(kGroup + "tasks", std::to_string(tid));
+    }
+}
+
+
+void xmrig::RxResctrl::leave()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    tids.erase(gettid());
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::RxResctrl::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::string schemata = read(kGroup + "schemata");
+    schemata.erase(schemata.find_last_not_of('\n') + 1);
+
+    // LLC occupancy from cache monitoring (CMT), per L3 domain
+    Value occupancy(kNullType);
+    DIR *dir = opendir((kGroup + "mon_data").c_str());
+
+    if (dir) {
+        uint64_t total = 0;
+        bool valid     = false;
+
+        while (dirent *entry = readdir(dir)) {
+            uint64_t value = 0;
+
+            if (strncmp(entry->d_name, "mon_L3_", 7) == 0 && sscanf(read(kGroup + "mon_data/" + entry->d_name + "/llc_occupancy").c_str(), "%" SCNu64, &value) == 1) {
+                total += value;
+                valid  = true;
+            }
+        }
+
+        closedir(dir);
+
+        if (valid) {
+            occupancy = total;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Value out(kObjectType);
+    out.AddMember("backend",        StringRef("resctrl"), allocator);
+    out.AddMember("schemata",       Value(schemata.c_str(), allocator), allocator);
+    out.AddMember("tasks",          static_cast<uint64_t>(tids.size()), allocator);
+    out.AddMember("llc-occupancy",  occupancy, allocator);
+
+    return out;
+}
+#endif
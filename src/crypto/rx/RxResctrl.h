@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_RXRESCTRL_H
+#define XMRIG_RXRESCTRL_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+namespace xmrig
+{
+
+
+class RxConfig;
+
+
+/**
+ * Cache QoS through the Linux resctrl filesystem: mining threads are moved into their own resource group with
+ * a configurable L3 way mask and memory bandwidth limit. Unlike the MSR implementation it needs no raw MSR access,
+ * follows threads instead of cores and doesn't overwrite classes of service owned by other resctrl users.
+ */
+class RxResctrl
+{
+public:
+    static inline bool isEnabled()      { return m_enabled; }
+    static inline bool isInitialized()  { return m_initialized; }
+
+    static bool init(const RxConfig &config);
+    static void destroy();
+    static void join();
+    static void leave();
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
+
+private:
+    static bool m_enabled;
+    static bool m_initialized;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RXRESCTRL_H */
@@ -20,6 +20,7 @@
 #include "hw/api/HwApi.h"
 #include "base/api/interfaces/IApiRequest.h"
 #include "base/tools/String.h"
+#include "core/Controller.h"
 
 
 #ifdef XMRIG_FEATURE_DMI
@@ -32,13 +33,20 @@ void xmrig::HwApi::onRequest(IApiRequest &request)
     if (request.method() == IApiRequest::METHOD_GET) {
 #       ifdef XMRIG_FEATURE_DMI
         if (request.url() == "/2/dmi") {
-            if (!m_dmi) {
-                m_dmi = std::make_shared<DmiReader>();
-                m_dmi->read();
+            const DmiReader *dmi = m_controller->dmi();
+
+            // Tables are read at startup, only read them here if the startup reader is disabled
+            if (!dmi) {
+                if (!m_dmi) {
+                    m_dmi = std::make_shared<DmiReader>();
+                    m_dmi->read();
+                }
+
+                dmi = m_dmi.get();
             }
 
             request.accept();
-            m_dmi->toJSON(request.reply(), request.doc());
+            dmi->toJSON(request.reply(), request.doc());
         }
 #       endif
     }
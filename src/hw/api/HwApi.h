@@ -29,18 +29,21 @@
 namespace xmrig {
 
 
+class Controller;
 class DmiReader;
 
 
 class HwApi : public IApiListener
 {
 public:
-    HwApi() = default;
+    inline HwApi(Controller *controller) : m_controller(controller) {}
 
 protected:
     void onRequest(IApiRequest &request) override;
 
 private:
+    Controller *m_controller;
+
 #   ifdef XMRIG_FEATURE_DMI
     std::shared_ptr<DmiReader> m_dmi;
 #   endif
@@ -0,0 +1,589 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/telemetry/CpuTelemetry.h"
+#include "3rdparty/fmt/core.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+
+namespace xmrig {
+
+
+constexpr static uint32_t kAPERF            = 0xE8;
+constexpr static uint32_t kMPERF            = 0xE7;
+constexpr static uint32_t kIntelRaplUnit    = 0x606;
+constexpr static uint32_t kIntelPkgEnergy   = 0x611;
+constexpr static uint32_t kAmdRaplUnit      = 0xC0010299;
+constexpr static uint32_t kAmdPkgEnergy     = 0xC001029B;
+
+
+static bool readUint(const std::string &path, uint64_t &value)
+{
+    FILE *fp = fopen(path.c_str(), "r");
+    if (!fp) {
+        return false;
+    }
+
+    unsigned long long v = 0;
+    const bool result    = fscanf(fp, "%llu", &v) == 1;
+    fclose(fp);
+
+    if (result) {
+        value = v;
+    }
+
+    return result;
+}
+
+
+static std::string readLine(const std::string &path)
+{
+    char buf[64] = { 0 };
+    FILE *fp     = fopen(path.c_str(), "r");
+
+    if (fp) {
+        if (!fgets(buf, sizeof(buf), fp)) {
+            buf[0] = '\0';
+        }
+
+        fclose(fp);
+    }
+
+    buf[strcspn(buf, "\n")] = '\0';
+
+    return buf;
+}
+
+
+static inline std::string cpuPath(int32_t cpu, const char *name)
+{
+    return fmt::format("/sys/devices/system/cpu/cpu{}/{}", cpu, name);
+}
+
+
+class CpuTelemetryPrivate
+{
+public:
+    struct CpuState
+    {
+        double base         = 0.0;  // MHz, MPERF frequency
+        uint32_t states     = 0;
+        uint64_t aperf      = 0;
+        uint64_t idle       = 0;
+        uint64_t mperf      = 0;
+    };
+
+    struct PackageState
+    {
+        double unit         = 0.0;  // J per counter step
+        int32_t cpu         = -1;
+        std::string energy;
+        std::string temperature;
+        uint32_t reg        = 0;
+        uint64_t last       = 0;
+        uint64_t range      = 0;
+    };
+
+    CpuTelemetryPrivate();
+    ~CpuTelemetryPrivate();
+
+    uint64_t idle(int32_t cpu, uint32_t states) const;
+    void initEnergy();
+    void initTemperature();
+    void sampleCpu(size_t i, double seconds, bool first);
+    void samplePackage(size_t i, double seconds, bool first);
+
+    bool ready                  = false;
+    const char *source          = "cpufreq";
+    std::vector<CpuState> cpuState;
+    std::vector<CpuTelemetry::Core> cores;
+    std::vector<CpuTelemetry::Package> packages;
+    std::vector<PackageState> packageState;
+    uint64_t ts                 = 0;
+    std::map<int32_t, int> msr;
+
+    // Read-only access to the msr device, it exists only when the msr module is already loaded
+    inline bool rdmsr(uint32_t reg, int32_t cpu, uint64_t &value) const
+    {
+        const auto it = msr.find(cpu);
+
+        return it != msr.end() && it->second >= 0 && pread(it->second, &value, sizeof(value), reg) == sizeof(value);
+    }
+};
+
+
+} // namespace xmrig
+
+
+xmrig::CpuTelemetryPrivate::CpuTelemetryPrivate()
+{
+    const auto &units = Cpu::info()->units();
+
+    cores.resize(units.size());
+    cpuState.resize(units.size());
+
+    for (size_t i = 0; i < units.size(); ++i) {
+        auto &core  = cores[i];
+        auto &state = cpuState[i];
+        core.cpu    = units[i];
+
+        // Never load the msr module or enable writes, telemetry should not change the system
+        msr[core.cpu] = open(fmt::format("/dev/cpu/{}/msr", core.cpu).c_str(), O_RDONLY | O_CLOEXEC);
+
+        uint64_t value = 0;
+        if (readUint(cpuPath(core.cpu, "topology/physical_package_id"), value)) {
+            core.package = static_cast<uint32_t>(value);
+        }
+
+        if (readUint(cpuPath(core.cpu, "cpufreq/base_frequency"), value) || readUint(cpuPath(core.cpu, "cpufreq/amd_pstate_nominal_freq"), value)) {
+            state.base = value / 1000.0;
+        }
+
+        while (access(cpuPath(core.cpu, fmt::format("cpuidle/state{}/time", state.states).c_str()).c_str(), R_OK) == 0) {
+            ++state.states;
+        }
+
+        if (std::find_if(packages.begin(), packages.end(), [&core](const CpuTelemetry::Package &p) { return p.id == core.package; }) == packages.end()) {
+            CpuTelemetry::Package package;
+            package.id = core.package;
+
+            PackageState pstate;
+            pstate.cpu = core.cpu;
+
+            packages.push_back(package);
+            packageState.push_back(pstate);
+        }
+    }
+
+    uint64_t value = 0;
+    if (!cpuState.empty() && cpuState.front().base > 0.0 && rdmsr(kMPERF, cores.front().cpu, value)) {
+        source = "aperf/mperf";
+    }
+
+    initTemperature();
+    initEnergy();
+}
+
+
+xmrig::CpuTelemetryPrivate::~CpuTelemetryPrivate()
+{
+    for (const auto &kv : msr) {
+        if (kv.second >= 0) {
+            close(kv.second);
+        }
+    }
+}
+
+
+uint64_t xmrig::CpuTelemetryPrivate::idle(int32_t cpu, uint32_t states) const
+{
+    uint64_t total = 0;
+    uint64_t value = 0;
+
+    for (uint32_t k = 0; k < states; ++k) {
+        if (readUint(cpuPath(cpu, fmt::format("cpuidle/state{}/time", k).c_str()), value)) {
+            total += value;
+        }
+    }
+
+    return total;
+}
+
+
+void xmrig::CpuTelemetryPrivate::initEnergy()
+{
+    for (size_t i = 0; i < packages.size(); ++i) {
+        for (uint32_t k = 0; k < 16; ++k) {
+            const std::string path = fmt::format("/sys/class/powercap/intel-rapl:{}/", k);
+
+            if (readLine(path + "name") == fmt::format("package-{}", packages[i].id)) {
+                uint64_t value = 0;
+
+                // energy_uj is root only on most kernels since 5.10
+                if (readUint(path + "energy_uj", value) && readUint(path + "max_energy_range_uj", packageState[i].range)) {
+                    packageState[i].energy = path + "energy_uj";
+                    packageState[i].unit   = 1e-6;
+                }
+
+                break;
+            }
+        }
+
+        if (!packageState[i].energy.empty()) {
+            continue;
+        }
+
+        const bool amd      = Cpu::info()->vendor() == ICpuInfo::VENDOR_AMD;
+        uint64_t unit       = 0;
+        uint64_t value      = 0;
+        const uint32_t reg  = amd ? kAmdPkgEnergy : kIntelPkgEnergy;
+
+        if (rdmsr(amd ? kAmdRaplUnit : kIntelRaplUnit, packageState[i].cpu, unit) && rdmsr(reg, packageState[i].cpu, value)) {
+            packageState[i].reg   = reg;
+            packageState[i].unit  = 1.0 / static_cast<double>(1ULL << ((unit >> 8) & 0x1F));
+            packageState[i].range = 0xFFFFFFFFULL;
+        }
+    }
+}
+
+
+void xmrig::CpuTelemetryPrivate::initTemperature()
+{
+    size_t amdIndex = 0;
+
+    for (uint32_t h = 0; h < 64; ++h) {
+        const std::string path = fmt::format("/sys/class/hwmon/hwmon{}/", h);
+        const std::string name = readLine(path + "name");
+
+        if (name.empty()) {
+            if (access(path.c_str(), F_OK) != 0) {
+                break;
+            }
+
+            continue;
+        }
+
+        if (name == "coretemp") {
+            for (uint32_t k = 1; k < 256; ++k) {
+                const std::string label = readLine(path + fmt::format("temp{}_label", k));
+                if (label.empty()) {
+                    if (k > 1) {
+                        break;
+                    }
+
+                    continue;
+                }
+
+                unsigned id = 0;
+                if (sscanf(label.c_str(), "Package id %u", &id) != 1) {
+                    continue;
+                }
+
+                for (size_t i = 0; i < packages.size(); ++i) {
+                    if (packages[i].id == id) {
+                        packageState[i].temperature = path + fmt::format("temp{}_input", k);
+                    }
+                }
+            }
+        }
+        else if ((name == "k10temp" || name == "zenpower") && amdIndex < packages.size()) {
+            // One device per socket in the package order, Tdie is the real die temperature when Tctl has an offset
+            std::string input;
+
+            for (uint32_t k = 1; k < 16; ++k) {
+                const std::string label = readLine(path + fmt::format("temp{}_label", k));
+                if (label == "Tdie" || (label == "Tctl" && input.empty())) {
+                    input = path + fmt::format("temp{}_input", k);
+                }
+            }
+
+            packageState[amdIndex++].temperature = input.empty() ? path + "temp1_input" : input;
+        }
+    }
+}
+
+
+void xmrig::CpuTelemetryPrivate::sampleCpu(size_t i, double seconds, bool first)
+{
+    auto &core  = cores[i];
+    auto &state = cpuState[i];
+
+    if (state.states) {
+        const uint64_t value = idle(core.cpu, state.states);
+
+        if (!first && value >= state.idle) {
+            core.c0 = std::min(std::max(1.0 - (value - state.idle) / 1e6 / seconds, 0.0), 1.0);
+        }
+
+        state.idle = value;
+    }
+
+    uint64_t aperf = 0;
+    uint64_t mperf = 0;
+
+    if (state.base > 0.0 && rdmsr(kAPERF, core.cpu, aperf) && rdmsr(kMPERF, core.cpu, mperf)) {
+        if (!first && mperf > state.mperf) {
+            core.freq = static_cast<uint32_t>(state.base * (aperf - state.aperf) / (mperf - state.mperf));
+        }
+
+        state.aperf = aperf;
+        state.mperf = mperf;
+    }
+    else {
+        uint64_t value = 0;
+        if (readUint(cpuPath(core.cpu, "cpufreq/scaling_cur_freq"), value)) {
+            core.freq = static_cast<uint32_t>(value / 1000);
+        }
+    }
+
+    core.peak      = std::max(core.peak, core.freq);
+    core.throttled = core.freq > 0 && (core.c0 < 0.0 || core.c0 >= 0.9) && core.freq * 10 < core.peak * 9;
+}
+
+
+void xmrig::CpuTelemetryPrivate::samplePackage(size_t i, double seconds, bool first)
+{
+    auto &package = packages[i];
+    auto &state   = packageState[i];
+
+    uint64_t value = 0;
+
+    if (!state.temperature.empty() && readUint(state.temperature, value)) {
+        package.temperature = value / 1000.0;
+    }
+
+    const bool valid = state.reg ? rdmsr(state.reg, state.cpu, value) : (!state.energy.empty() && readUint(state.energy, value));
+    if (!valid) {
+        return;
+    }
+
+    if (state.reg) {
+        value &= 0xFFFFFFFFULL;
+    }
+
+    if (!first) {
+        const uint64_t delta = value >= state.last ? value - state.last : value + state.range - state.last;
+        const double joules  = delta * state.unit;
+
+        package.power   = joules / seconds;
+        package.energy += joules;
+    }
+
+    state.last = value;
+}
+
+
+xmrig::CpuTelemetry::CpuTelemetry() :
+    d_ptr(new CpuTelemetryPrivate())
+{
+}
+
+
+xmrig::CpuTelemetry::~CpuTelemetry()
+{
+    delete d_ptr;
+}
+
+
+bool xmrig::CpuTelemetry::isReady() const
+{
+    return d_ptr->ready;
+}
+
+
+const char *xmrig::CpuTelemetry::source() const
+{
+    return d_ptr->source;
+}
+
+
+const xmrig::CpuTelemetry::Core *xmrig::CpuTelemetry::core(int64_t cpu) const
+{
+    for (const auto &core : d_ptr->cores) {
+        if (core.cpu == cpu) {
+            return &core;
+        }
+    }
+
+    return nullptr;
+}
+
+
+const std::vector<xmrig::CpuTelemetry::Core> &xmrig::CpuTelemetry::cores() const
+{
+    return d_ptr->cores;
+}
+
+
+const std::vector<xmrig::CpuTelemetry::Package> &xmrig::CpuTelemetry::packages() const
+{
+    return d_ptr->packages;
+}
+
+
+double xmrig::CpuTelemetry::energy() const
+{
+    double total = 0.0;
+    for (const auto &package : d_ptr->packages) {
+        total += package.energy;
+    }
+
+    return total;
+}
+
+
+double xmrig::CpuTelemetry::power() const
+{
+    double total = 0.0;
+    for (const auto &package : d_ptr->packages) {
+        if (package.power < 0.0) {
+            return -1.0;
+        }
+
+        total += package.power;
+    }
+
+    return d_ptr->packages.empty() ? -1.0 : total;
+}
+
+
+void xmrig::CpuTelemetry::print(double hashrate) const
+{
+    if (!isReady()) {
+        return;
+    }
+
+    for (const auto &package : d_ptr->packages) {
+        uint32_t min        = 0;
+        uint32_t max        = 0;
+        uint64_t sum        = 0;
+        size_t count        = 0;
+        double c0           = 0.0;
+        size_t c0count      = 0;
+        std::string throttled;
+
+        for (const auto &core : d_ptr->cores) {
+            if (core.package != package.id || core.freq == 0) {
+                continue;
+            }
+
+            min  = count ? std::min(min, core.freq) : core.freq;
+            max  = std::max(max, core.freq);
+            sum += core.freq;
+            ++count;
+
+            if (core.c0 >= 0.0) {
+                c0 += core.c0;
+                ++c0count;
+            }
+
+            if (core.throttled) {
+                throttled += fmt::format("{}{}", throttled.empty() ? "" : ",", core.cpu);
+            }
+        }
+
+        char power[16]  = "n/a";
+        char temp[16]   = "n/a";
+        char hpj[16]    = "n/a";
+
+        if (package.power >= 0.0) {
+            snprintf(power, sizeof(power), "%.1fW", package.power);
+        }
+
+        if (package.temperature >= 0.0) {
+            snprintf(temp, sizeof(temp), "%.0fC", package.temperature);
+        }
+
+        if (d_ptr->packages.size() == 1 && hashrate > 0.0 && package.power > 0.0) {
+            snprintf(hpj, sizeof(hpj), "%.2f", hashrate / package.power);
+        }
+
+        LOG_INFO("%s" CYAN_BOLD(" #%u") MAGENTA_BOLD(" %s") CSI "1;%um %s" CLEAR CYAN_BOLD(" %" PRIu64 "/%u/%u") CYAN(" MHz") " C0 " WHITE_BOLD("%.0f%%") " H/J " WHITE_BOLD("%s"),
+                 Tags::cpu(),
+                 package.id,
+                 power,
+                 package.temperature < 0.0 ? 37 : (package.temperature < 70.0 ? 32 : (package.temperature > 90.0 ? 31 : 33)),
+                 temp,
+                 count ? sum / count : 0,
+                 min,
+                 max,
+                 c0count ? c0 * 100.0 / c0count : 0.0,
+                 hpj
+                 );
+
+        if (!throttled.empty()) {
+            LOG_WARN("%s" CYAN_BOLD(" #%u") YELLOW(" throttled CPUs ") YELLOW_BOLD("%s") YELLOW(" run more than 10%% below their peak frequency"), Tags::cpu(), package.id, throttled.c_str());
+        }
+    }
+}
+
+
+void xmrig::CpuTelemetry::sample()
+{
+    const uint64_t now  = Chrono::steadyMSecs();
+    const bool first    = d_ptr->ts == 0;
+    const double seconds = first ? 0.0 : std::max(now - d_ptr->ts, uint64_t(1)) / 1000.0;
+
+    for (size_t i = 0; i < d_ptr->cores.size(); ++i) {
+        d_ptr->sampleCpu(i, seconds, first);
+    }
+
+    for (size_t i = 0; i < d_ptr->packages.size(); ++i) {
+        d_ptr->samplePackage(i, seconds, first);
+    }
+
+    d_ptr->ts    = now;
+    d_ptr->ready = !first;
+}
+
+
+rapidjson::Value xmrig::CpuTelemetry::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    auto optional = [](double value) { return value >= 0.0 ? Json::normalize(value, false) : Value(kNullType); };
+
+    Value packages(kArrayType);
+    for (const auto &package : d_ptr->packages) {
+        Value obj(kObjectType);
+        obj.AddMember("id",             package.id, allocator);
+        obj.AddMember("temperature",    optional(package.temperature), allocator);
+        obj.AddMember("power",          optional(package.power), allocator);
+        obj.AddMember("energy",         Json::normalize(package.energy, false), allocator);
+
+        packages.PushBack(obj, allocator);
+    }
+
+    Value cores(kArrayType);
+    for (const auto &core : d_ptr->cores) {
+        Value obj(kObjectType);
+        obj.AddMember("cpu",        core.cpu, allocator);
+        obj.AddMember("package",    core.package, allocator);
+        obj.AddMember("freq",       core.freq, allocator);
+        obj.AddMember("peak",       core.peak, allocator);
+        obj.AddMember("c0",         optional(core.c0), allocator);
+        obj.AddMember("throttled",  core.throttled, allocator);
+
+        cores.PushBack(obj, allocator);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("source",     StringRef(d_ptr->source), allocator);
+    out.AddMember("power",      optional(power()), allocator);
+    out.AddMember("energy",     Json::normalize(energy(), false), allocator);
+    out.AddMember("packages",   packages, allocator);
+    out.AddMember("cores",      cores, allocator);
+
+    return out;
+}
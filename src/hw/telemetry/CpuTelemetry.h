@@ -0,0 +1,93 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUTELEMETRY_H
+#define XMRIG_CPUTELEMETRY_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class CpuTelemetryPrivate;
+
+
+/**
+ * Periodic sampler of per CPU frequency and C0 residency, package temperature and package power.
+ *
+ * Every value is an average over the interval between the two last sample() calls. Frequency comes from
+ * APERF/MPERF when the msr module is loaded, from cpufreq otherwise; C0 residency from cpuidle; temperature
+ * from hwmon (coretemp, k10temp, zenpower); power from powercap RAPL or the RAPL MSRs. Values which can't be
+ * read on this host stay unknown (negative or 0) and are reported as null.
+ */
+class CpuTelemetry
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CpuTelemetry)
+
+    constexpr static uint64_t kInterval = 10000;
+
+    struct Core
+    {
+        bool throttled  = false;    // busy but more than 10% below the highest frequency seen on this CPU
+        double c0       = -1.0;
+        int32_t cpu     = -1;
+        uint32_t freq   = 0;        // MHz
+        uint32_t peak   = 0;
+        uint32_t package = 0;
+    };
+
+    struct Package
+    {
+        double power        = -1.0; // W
+        double temperature  = -1.0; // C
+        double energy       = 0.0;  // J since the first sample
+        uint32_t id         = 0;
+    };
+
+    CpuTelemetry();
+    ~CpuTelemetry();
+
+    bool isReady() const;
+    const char *source() const;
+    const Core *core(int64_t cpu) const;
+    const std::vector<Core> &cores() const;
+    const std::vector<Package> &packages() const;
+    double energy() const;
+    double power() const;
+    void print(double hashrate) const;
+    void sample();
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    CpuTelemetryPrivate *d_ptr;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_CPUTELEMETRY_H
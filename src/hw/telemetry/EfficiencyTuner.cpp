@@ -0,0 +1,279 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/telemetry/EfficiencyTuner.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "hw/telemetry/CpuTelemetry.h"
+
+
+#ifdef XMRIG_FEATURE_MSR
+#   include "hw/msr/Msr.h"
+#endif
+
+
+#include <algorithm>
+
+
+namespace xmrig {
+
+
+constexpr static double kMinGain            = 0.01;
+constexpr static uint32_t kMeasure          = 6;    // telemetry samples, 60 seconds
+constexpr static uint32_t kMinPowerLimit    = 50;
+constexpr static uint32_t kPowerLimitStep   = 10;
+constexpr static uint32_t kWarmup           = 3;
+constexpr static uint32_t kPkgPowerLimit    = 0x610;
+
+
+} // namespace xmrig
+
+
+xmrig::EfficiencyTuner::EfficiencyTuner(const CpuTelemetry &telemetry, bool powerLimit) :
+    m_telemetry(telemetry),
+    m_powerLimit(powerLimit)
+{
+    initPowerLimit();
+}
+
+
+xmrig::EfficiencyTuner::~EfficiencyTuner()
+{
+    setPowerLimit(100);
+}
+
+
+bool xmrig::EfficiencyTuner::update(const Hashrate *hashrate, uint64_t now)
+{
+    if (m_stage == HOLD || !hashrate || !m_telemetry.isReady()) {
+        return false;
+    }
+
+    if (m_telemetry.power() < 0.0) {
+        LOG_WARN("%s " YELLOW("efficiency mode disabled, package energy counters are not available (RAPL requires root or the msr module)"), Tags::cpu());
+        m_stage = HOLD;
+
+        return false;
+    }
+
+    // Paused or restarting, the window is measured again
+    if (hashrate->calc(Hashrate::ShortInterval) <= 0.0) {
+        m_samples = 0;
+
+        return false;
+    }
+
+    if (++m_samples == kWarmup) {
+        m_energy = m_telemetry.energy();
+        m_ts     = now;
+
+        return false;
+    }
+
+    if (m_samples < kWarmup + kMeasure) {
+        return false;
+    }
+
+    const double seconds = std::max<uint64_t>(now - m_ts, 1) / 1000.0;
+
+    m_current.hashrate   = hashrate->calc(now - m_ts);
+    m_current.power      = (m_telemetry.energy() - m_energy) / seconds;
+    m_current.efficiency = m_current.power > 0.0 ? m_current.hashrate / m_current.power : 0.0;
+    m_samples            = 0;
+
+    LOG_INFO("%s " MAGENTA_BOLD("efficiency") " threads " CYAN_BOLD("%u") " intensity " CYAN_BOLD("%u") " power limit " CYAN_BOLD("%u%%") WHITE_BOLD(" %.1f H/s") MAGENTA_BOLD(" %.1fW") GREEN_BOLD(" %.2f H/J"),
+             Tags::cpu(),
+             m_current.threads,
+             m_current.intensity,
+             m_current.powerLimit,
+             m_current.hashrate,
+             m_current.power,
+             m_current.efficiency
+             );
+
+    if (m_current.efficiency > m_best.efficiency * (1.0 + kMinGain)) {
+        m_best = m_current;
+    }
+    else {
+        m_stage = static_cast<Stage>(m_stage + 1);
+    }
+
+    const Point previous = m_current;
+    if (!next()) {
+        LOG_INFO("%s " MAGENTA_BOLD("efficiency") " hold threads " CYAN_BOLD("%u") " intensity " CYAN_BOLD("%u") " power limit " CYAN_BOLD("%u%%") GREEN_BOLD(" %.2f H/J"),
+                 Tags::cpu(),
+                 m_best.threads,
+                 m_best.intensity,
+                 m_best.powerLimit,
+                 m_best.efficiency
+                 );
+    }
+
+    return previous.threads != m_current.threads || previous.intensity != m_current.intensity;
+}
+
+
+void xmrig::EfficiencyTuner::reset(const Algorithm &algorithm, uint32_t threads, uint32_t intensity)
+{
+    m_algorithm          = algorithm;
+    m_current            = Point();
+    m_current.threads    = threads;
+    m_current.intensity  = intensity;
+    m_best               = m_current;
+    m_maxThreads         = threads;
+    m_samples            = 0;
+    m_stage              = THREADS;
+
+    setPowerLimit(100);
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::EfficiencyTuner::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    static const char *stages[] = { "threads", "intensity", "power-limit", "hold" };
+
+    auto point = [&allocator](const Point &p) {
+        Value obj(kObjectType);
+        obj.AddMember("threads",        p.threads, allocator);
+        obj.AddMember("intensity",      p.intensity, allocator);
+        obj.AddMember("power-limit",    p.powerLimit, allocator);
+        obj.AddMember("hashrate",       Json::normalize(p.hashrate, false), allocator);
+        obj.AddMember("power",          Json::normalize(p.power, false), allocator);
+        obj.AddMember("hashes-per-joule", Json::normalize(p.efficiency, false), allocator);
+
+        return obj;
+    };
+
+    Value out(kObjectType);
+    out.AddMember("stage",      StringRef(stages[m_stage]), allocator);
+    out.AddMember("current",    point(m_current), allocator);
+    out.AddMember("best",       point(m_best), allocator);
+
+    return out;
+}
+#endif
+
+
+bool xmrig::EfficiencyTuner::next()
+{
+    while (m_stage != HOLD) {
+        Point candidate;
+        candidate.threads    = m_best.threads;
+        candidate.intensity  = m_best.intensity;
+        candidate.powerLimit = m_best.powerLimit;
+
+        const uint32_t step      = std::max(m_maxThreads / 8, 1U);
+        const uint32_t intensity = m_stage == INTENSITY ? lowerIntensity() : 0;
+
+        if (m_stage == THREADS && m_best.threads > step) {
+            candidate.threads -= step;
+        }
+        else if (m_stage == INTENSITY && intensity > 0) {
+            candidate.intensity = intensity;
+        }
+        else if (m_stage == POWER_LIMIT && !m_limits.empty() && m_best.powerLimit >= kMinPowerLimit + kPowerLimitStep) {
+            candidate.powerLimit -= kPowerLimitStep;
+        }
+        else {
+            m_stage = static_cast<Stage>(m_stage + 1);
+            continue;
+        }
+
+        m_current = candidate;
+        setPowerLimit(m_current.powerLimit);
+
+        return true;
+    }
+
+    m_current = m_best;
+    setPowerLimit(m_best.powerLimit);
+
+    return false;
+}
+
+
+// Next lower intensity which the workers actually run, for example CryptoNight goes from 8 straight to 5
+uint32_t xmrig::EfficiencyTuner::lowerIntensity() const
+{
+    for (uint32_t intensity = m_best.intensity; intensity > 1; --intensity) {
+        const uint32_t clamped = CpuLaunchData::clampIntensity(m_algorithm, intensity - 1);
+        if (clamped < m_best.intensity) {
+            return clamped;
+        }
+    }
+
+    return 0;
+}
+
+
+void xmrig::EfficiencyTuner::initPowerLimit()
+{
+#   ifdef XMRIG_FEATURE_MSR
+    if (!m_powerLimit || Cpu::info()->vendor() != ICpuInfo::VENDOR_INTEL || m_telemetry.cores().empty()) {
+        return;
+    }
+
+    m_msr = Msr::get();
+    if (!m_msr) {
+        return;
+    }
+
+    for (const auto &package : m_telemetry.packages()) {
+        const auto it = std::find_if(m_telemetry.cores().begin(), m_telemetry.cores().end(), [&package](const CpuTelemetry::Core &core) { return core.package == package.id; });
+        const MsrItem item = m_msr->read(kPkgPowerLimit, it->cpu, false);
+
+        // Bit 63 locks the register until reset
+        if (!item.isValid() || (item.value() >> 63) || (item.value() & 0x7FFF) == 0) {
+            LOG_WARN("%s " YELLOW("efficiency mode can't change the package power limit (locked or not supported)"), Tags::cpu());
+            m_limits.clear();
+
+            return;
+        }
+
+        Limit limit;
+        limit.cpu      = it->cpu;
+        limit.original = item.value() & 0xFFFF;
+
+        m_limits.push_back(limit);
+    }
+#   endif
+}
+
+
+void xmrig::EfficiencyTuner::setPowerLimit(uint32_t percent)
+{
+#   ifdef XMRIG_FEATURE_MSR
+    for (const auto &limit : m_limits) {
+        // PL1 is bits 14:0 in power units and bit 15 enables it, the time window and PL2 are left as is
+        const uint64_t pl1   = std::max<uint64_t>((limit.original & 0x7FFF) * percent / 100, 1);
+        const uint64_t value = percent >= 100 ? limit.original : (pl1 | 0x8000);
+
+        m_msr->write(kPkgPowerLimit, value, limit.cpu, 0xFFFF, false);
+    }
+#   endif
+}
@@ -0,0 +1,118 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_EFFICIENCYTUNER_H
+#define XMRIG_EFFICIENCYTUNER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class CpuTelemetry;
+class Hashrate;
+class Msr;
+
+
+/**
+ * Searches for the operating point with the best hashes per joule and holds it.
+ *
+ * Every candidate runs for a warmup and a measurement window, efficiency is the average hashrate divided by the
+ * average package power from the energy counters over the same window. The search walks down from the configured
+ * maximum: thread count first (threads are dropped from the end of the profile, that is SMT siblings and efficiency
+ * cores only if the cache budget placed them last, otherwise whole cores of the last cache), then intensity (only
+ * values which remain distinct after clamping), then optionally the Intel package power limit (PL1). A stage ends
+ * at the first candidate which is not at least 1% better than the best one.
+ */
+class EfficiencyTuner
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(EfficiencyTuner)
+
+    struct Point
+    {
+        double efficiency   = 0.0;  // H/J
+        double hashrate     = 0.0;
+        double power        = 0.0;
+        uint32_t intensity  = 0;
+        uint32_t powerLimit = 100;  // % of the original PL1
+        uint32_t threads    = 0;
+    };
+
+    EfficiencyTuner(const CpuTelemetry &telemetry, bool powerLimit);
+    ~EfficiencyTuner();
+
+    inline bool isDone() const              { return m_stage == HOLD; }
+    inline const Point &best() const        { return m_best; }
+    inline const Point &current() const     { return m_current; }
+
+    bool update(const Hashrate *hashrate, uint64_t now);
+    void reset(const Algorithm &algorithm, uint32_t threads, uint32_t intensity);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    enum Stage : uint32_t {
+        THREADS,
+        INTENSITY,
+        POWER_LIMIT,
+        HOLD
+    };
+
+    struct Limit
+    {
+        int32_t cpu         = -1;
+        uint64_t original   = 0;    // PL1 in power units
+    };
+
+    bool next();
+    uint32_t lowerIntensity() const;
+    void initPowerLimit();
+    void setPowerLimit(uint32_t percent);
+
+    Algorithm m_algorithm;
+    const CpuTelemetry &m_telemetry;
+    bool m_powerLimit;
+    double m_energy         = 0.0;
+    Point m_best;
+    Point m_current;
+    Stage m_stage           = HOLD;
+    std::shared_ptr<Msr> m_msr;
+    std::vector<Limit> m_limits;
+    uint32_t m_maxThreads   = 0;
+    uint32_t m_samples      = 0;
+    uint64_t m_ts           = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_EFFICIENCYTUNER_H
@@ -0,0 +1,15 @@
+if (WITH_TELEMETRY AND XMRIG_OS_LINUX)
+    add_definitions(/DXMRIG_FEATURE_TELEMETRY)
+
+    list(APPEND HEADERS
+        src/hw/telemetry/CpuTelemetry.h
+        src/hw/telemetry/EfficiencyTuner.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/telemetry/CpuTelemetry.cpp
+        src/hw/telemetry/EfficiencyTuner.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_TELEMETRY)
+endif()
@@ -41,6 +41,7 @@
 
 
 #ifdef XMRIG_ALGO_KAWPOW
+#   include "base/tools/Chrono.h"
 #   include "crypto/kawpow/KPCache.h"
 #   include "crypto/kawpow/KPHash.h"
 #endif
@@ -146,6 +147,19 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
     }
     else if (algorithm.family() == Algorithm::KAWPOW) {
 #       ifdef XMRIG_ALGO_KAWPOW
+        const uint64_t height = bundle.job.height();
+        const auto cache      = KPCache::get(static_cast<uint32_t>(height / KPHash::EPOCH_LENGTH));
+        if (!cache || !KPCache::selfTest()) {
+            errors += bundle.nonces.size();
+            delete memory;
+
+            return;
+        }
+
+        KPCache::prepare(height);
+
+        const double ts = Chrono::highResolutionMSecs();
+
         for (uint32_t nonce : bundle.nonces) {
             *bundle.job.nonce() = nonce;
 
@@ -156,12 +170,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             uint32_t output[8];
             uint32_t mix_hash[8];
-            {
-                std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-
-                KPCache::s_cache.init(bundle.job.height() / KPHash::EPOCH_LENGTH);
-                KPHash::calculate(KPCache::s_cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
-            }
+            KPHash::calculate(*cache, static_cast<uint32_t>(height), header_hash, full_nonce, output, mix_hash);
 
             for (size_t i = 0; i < sizeof(hash); ++i) {
                 hash[i] = ((uint8_t*)output)[sizeof(hash) - 1 - i];
@@ -175,6 +184,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
                 ++errors;
             }
         }
+
+        KPCache::addVerified(bundle.nonces.size(), Chrono::highResolutionMSecs() - ts);
 #       endif
     }
     else {
@@ -188,6 +199,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             checkHash(bundle, results, nonce, hash, errors);
         }
+
+        CnCtx::release(ctx, 1);
     }
 
     delete memory;
@@ -251,30 +264,32 @@ private:
             m_listener->onJobResult(result);
         }
 
-        if (bundles.empty()) {
-            return;
-        }
+        // One work request per bundle, the libuv thread pool verifies results from different devices in parallel
+        while (!bundles.empty()) {
+            std::list<JobBundle> bundle;
+            bundle.splice(bundle.end(), bundles, bundles.begin());
 
-        auto baton = new JobBaton(std::move(bundles), m_listener, m_hwAES);
+            auto baton = new JobBaton(std::move(bundle), m_listener, m_hwAES);
 
-        uv_queue_work(uv_default_loop(), &baton->req,
-            [](uv_work_t *req) {
-                auto baton = static_cast<JobBaton*>(req->data);
+            uv_queue_work(uv_default_loop(), &baton->req,
+                [](uv_work_t *req) {
+                    auto baton = static_cast<JobBaton*>(req->data);
 
-                for (JobBundle &bundle : baton->bundles) {
-                    getResults(bundle, baton->results, baton->errors, baton->hwAES);
-                }
-            },
-            [](uv_work_t *req, int) {
-                auto baton = static_cast<JobBaton*>(req->data);
+                    for (JobBundle &bundle : baton->bundles) {
+                        getResults(bundle, baton->results, baton->errors, baton->hwAES);
+                    }
+                },
+                [](uv_work_t *req, int) {
+                    auto baton = static_cast<JobBaton*>(req->data);
 
-                for (const auto &result : baton->results) {
-                    baton->listener->onJobResult(result);
-                }
+                    for (const auto &result : baton->results) {
+                        baton->listener->onJobResult(result);
+                    }
 
-                delete baton;
-            }
-        );
+                    delete baton;
+                }
+            );
+        }
     }
 #   else
     inline void submit()
@@ -331,6 +346,10 @@ void xmrig::JobResults::stop()
     delete handler;
 
     handler = nullptr;
+
+#   ifdef XMRIG_ALGO_KAWPOW
+    KPCache::release();
+#   endif
 }
 
 
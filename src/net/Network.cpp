@@ -26,6 +26,7 @@
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Startup.h"
 #include "base/net/stratum/Client.h"
 #include "base/net/stratum/NetworkState.h"
 #include "base/net/stratum/SubmitResult.h"
@@ -45,6 +46,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_HTTP
+#   include "base/api/EventStream.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/BenchState.h"
 #endif
@@ -57,6 +63,33 @@
 #include <memory>
 
 
+namespace xmrig {
+
+
+// Structured events go to the JSON log and to the HTTP API event feed.
+static inline bool isEvents()
+{
+#   ifdef XMRIG_FEATURE_HTTP
+    return Log::isEvents() || EventStream::isActive();
+#   else
+    return Log::isEvents();
+#   endif
+}
+
+
+static void publish(Log::Level level, const char *type, const rapidjson::Value &value)
+{
+    Log::event(level, type, value);
+
+#   ifdef XMRIG_FEATURE_HTTP
+    EventStream::publish(type, value);
+#   endif
+}
+
+
+} // namespace xmrig
+
+
 xmrig::Network::Network(Controller *controller) :
     m_controller(controller)
 {
@@ -223,7 +256,7 @@ void xmrig::Network::onPause(IStrategy *strategy)
 }
 
 
-void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult &result, const char *error)
+void xmrig::Network::onResultAccepted(IStrategy *, IClient *client, const SubmitResult &result, const char *error)
 {
     uint64_t diff     = result.diff;
     const char *scale = NetworkState::scaleDiff(diff);
@@ -236,6 +269,24 @@ void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult
         LOG_INFO("%s " GREEN_BOLD("accepted") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " BLACK_BOLD("(%" PRIu64 " ms)"),
                  backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, result.elapsed);
     }
+
+    if (isEvents()) {
+        using namespace rapidjson;
+        static const char *backends[] = { "cpu", "opencl", "cuda" };
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("pool",        client->pool().url().toJSON(), allocator);
+        doc.AddMember("accepted",    error == nullptr, allocator);
+        doc.AddMember("backend",     StringRef(result.backend < 3 ? backends[result.backend] : "unknown"), allocator);
+        doc.AddMember("diff",        result.diff, allocator);
+        doc.AddMember("actual_diff", result.actualDiff, allocator);
+        doc.AddMember("latency",     result.elapsed, allocator);
+        doc.AddMember("error",       error ? Value(error, allocator) : Value(kNullType), allocator);
+
+        publish(error ? Log::WARNING : Log::INFO, "share", doc);
+    }
 }
 
 
@@ -258,6 +309,11 @@ void xmrig::Network::onRequest(IApiRequest &request)
         getResults(request.reply(), request.doc(), request.version());
         getConnection(request.reply(), request.doc(), request.version());
     }
+    else if (request.type() == IApiRequest::REQ_SNAPSHOT) {
+        request.accept();
+
+        m_state->getResults(request.snapshot());
+    }
 }
 #endif
 
@@ -296,7 +352,24 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
         m_donate->setProxy(client->pool().proxy());
     }
 
+    Startup::mark("job");
     m_controller->miner()->setJob(job, donate);
+
+    if (isEvents()) {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("pool",   client->pool().url().toJSON(), allocator);
+        doc.AddMember("job_id", job.id().toJSON(), allocator);
+        doc.AddMember("algo",   StringRef(job.algorithm().name()), allocator);
+        doc.AddMember("diff",   job.diff(), allocator);
+        doc.AddMember("height", job.height(), allocator);
+        doc.AddMember("donate", donate, allocator);
+
+        publish(Log::INFO, "job", doc);
+    }
 }
 
 